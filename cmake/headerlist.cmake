@@ -4,6 +4,7 @@ set(headers ${headers}
 	include/Utils.h
 	include/PCH.h
 	include/logger.h
+	include/HotLog.h
 	include/Settings.h
 	include/HazardMgr.h
 	include/Events.h
@@ -11,4 +12,6 @@ set(headers ${headers}
 	include/MCP.h
 	include/Serialization.h
 	include/WildfireMgr.h
+	include/SkyrimLand.h
+	include/SourceMatcher.h
 )
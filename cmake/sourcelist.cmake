@@ -1,5 +1,4 @@
 set(sources ${sources}
-	src/Types.cpp
 	src/DrawDebug.cpp
 	src/Events.cpp
 	src/plugin.cpp
@@ -10,4 +9,6 @@ set(sources ${sources}
 	src/MCP.cpp
  	src/Serialization.cpp
 	src/WildfireMgr.cpp
+	src/SkyrimLand.cpp
+	src/SourceMatcher.cpp
 )
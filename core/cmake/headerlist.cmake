@@ -0,0 +1,18 @@
+set(core_headers ${core_headers}
+	include/WildfireCore/Types.h
+	include/WildfireCore/SimSettings.h
+	include/WildfireCore/LandProvider.h
+	include/WildfireCore/CellGrid.h
+	include/WildfireCore/CellImage.h
+	include/WildfireCore/CellRegistry.h
+	include/WildfireCore/CellStatePool.h
+	include/WildfireCore/ColdCellStore.h
+	include/WildfireCore/FireCellState.h
+	include/WildfireCore/ImpactQueue.h
+	include/WildfireCore/RebuildScheduler.h
+	include/WildfireCore/BurnKernel.h
+	include/WildfireCore/FireSimulation.h
+	include/WildfireCore/SyntheticLand.h
+	include/WildfireCore/ThreadPool.h
+	include/WildfireCore/TextureFuelTable.h
+)
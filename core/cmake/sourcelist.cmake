@@ -0,0 +1,14 @@
+set(core_sources ${core_sources}
+	src/BurnKernel.cpp
+	src/CellImage.cpp
+	src/CellRegistry.cpp
+	src/CellStatePool.cpp
+	src/ColdCellStore.cpp
+	src/FireCellState.cpp
+	src/FireSimulation.cpp
+	src/ImpactQueue.cpp
+	src/RebuildScheduler.cpp
+	src/SyntheticLand.cpp
+	src/ThreadPool.cpp
+	src/TextureFuelTable.cpp
+)
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "WildfireCore/FireCellState.h"
+
+#include <cstdint>
+
+// Tick constants shared by every vertex
+struct BurnParams {
+    float spreadScale;       // delta / HeatDistributionFactor
+    float fuelBurn;          // FuelConsumptionRate * delta
+    float heatGain;          // FuelConsumptionRate * FuelToHeatRate * delta
+    float selfHeatLoss;      // SelfHeatLoss * delta
+    float spreadWeights[8];  // Share of spread heat per direction, CellGrid::NeighbourOffsets order
+};
+
+// Arithmetic part of the tick for one row of a cell: burning vertices lose heat to their neighbours, burn fuel and
+// char, heated ones cool down, and every vertex sums the heat its burning neighbours spread towards it.
+// Only the columns set in the columns mask are written. next must hold a copy of the current buffer, its flags are
+// final afterwards while incoming / hits receive the pulled heat and the number of neighbours it came from.
+// Colors, ignitions and applying the pulled heat stay with the caller.
+struct BurnKernel {
+    using RowFunc = void (*)(const FireCellState& state, FireCellState::Buffer& next, int row, uint64_t columns,
+                             const BurnParams& params, float* incoming, int32_t* hits);
+
+    const char* name;
+    RowFunc run;
+};
+
+// Fastest kernel the CPU supports, picked on first use. Every kernel produces bit identical results.
+// Setting the WILDFIRE_SCALAR_KERNEL environment variable forces the scalar one.
+const BurnKernel& GetBurnKernel();
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "WildfireCore/Types.h"
+
+// Stitched vertex grid of a cell.
+// The 4 quadrants of 17x17 vertices share their seams, together they form one 33x33 grid with row 0 / column 0 at
+// the cell origin. Grids are stored with a ghost ring of one vertex around them that mirrors the neighbouring cells,
+// rows are padded so every row starts on a 32 byte boundary and can be walked in blocks of 8 from the ghost column.
+namespace CellGrid {
+    constexpr int Size = 33;        // Vertices per row and column of a cell
+    constexpr int Stride = 40;      // Stored entries per row, ghost columns and padding included
+    constexpr int Rows = Size + 2;  // Stored rows, ghost rows included
+    constexpr int Margin = 8;       // Unused entries around the rows, neighbour reads of a whole block stay inside
+    constexpr int Cells = Margin + Rows * Stride + Margin;  // Stored entries per grid
+    constexpr int Alignment = 64;                           // Cache line
+
+    // Index of vertex (row, col) in a stored grid, -1 and Size address the ghost ring
+    constexpr int Index(int row, int col) { return Margin + (row + 1) * Stride + col + 1; }
+
+    // Offsets to the 8 neighbours of a stored vertex, ordered NW, N, NE, W, E, SW, S, SE (row - 1 first).
+    // The neighbour in direction d sees this vertex in direction 7 - d.
+    constexpr int NeighbourOffsets[8] = {-Stride - 1, -Stride, -Stride + 1, -1, 1, Stride - 1, Stride, Stride + 1};
+
+    // Blocks of 8x8 vertices color changes are tracked in, 4 per row. The last row and column of the grid belong to
+    // the last tiles, which makes them 9 vertices wide.
+    constexpr int TileSize = 8;
+    constexpr int TilesPerRow = 4;
+    constexpr int Tiles = TilesPerRow * TilesPerRow;
+    constexpr int Tile(int row, int col) {
+        return (row < Size - 1 ? row / TileSize : TilesPerRow - 1) * TilesPerRow +
+               (col < Size - 1 ? col / TileSize : TilesPerRow - 1);
+    }
+
+    struct QuadrantVertex {
+        int quadrant;
+        int vertex;
+    };
+
+    constexpr int Row(int quadrant, int vertex) { return (quadrant / 2) * 16 + vertex / VertsPerQuadRow; }
+    constexpr int Col(int quadrant, int vertex) { return (quadrant % 2) * 16 + vertex % VertsPerQuadRow; }
+    constexpr int QuadrantIndex(int quadrant, int vertex) {
+        return Index(Row(quadrant, vertex), Col(quadrant, vertex));
+    }
+
+    // Lowest quadrant holding the grid vertex
+    constexpr QuadrantVertex ToQuadrant(int row, int col) {
+        int qx = col > 16 ? 1 : 0;
+        int qy = row > 16 ? 1 : 0;
+        return {qy * 2 + qx, (row - qy * 16) * VertsPerQuadRow + (col - qx * 16)};
+    }
+
+    constexpr FireVertex ToFireVertex(const CellCoord& cell, int row, int col) {
+        auto [quadrant, vertex] = ToQuadrant(row, col);
+        return FireVertex{cell, quadrant, vertex};
+    }
+
+    // Every quadrant holding the grid vertex, seam vertices are stored by 2 or 4 quadrants. Returns the count.
+    constexpr int QuadrantCopies(int row, int col, QuadrantVertex (&out)[4]) {
+        int count = 0;
+        for (int qy = 0; qy < 2; ++qy) {
+            int vy = row - qy * 16;
+            if (vy < 0 || vy > 16) continue;
+            for (int qx = 0; qx < 2; ++qx) {
+                int vx = col - qx * 16;
+                if (vx < 0 || vx > 16) continue;
+                out[count++] = {qy * 2 + qx, vy * VertsPerQuadRow + vx};
+            }
+        }
+        return count;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "WildfireCore/FireCellState.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Portable image of what the fire left in one cell, shared by cold storage and saves.
+// A section byte is followed by runs of (length, value) varints over the 33x33 grid in row-major order: the charred
+// mask and the fuel in CompactFireCell steps, then the burning mask and zigzag heat steps when the cell still has
+// heat, and last the color delta, how much darker than the original every color byte is, when it was captured.
+// Untouched ranges collapse into single runs, a singed cell takes a few hundred bytes.
+namespace CellImage {
+    constexpr uint8_t HasFire = 1;    // Burning mask and heat follow the fuel
+    constexpr uint8_t HasColors = 2;  // The color delta closes the image
+
+    // Appends the image of a cell, colors are the ones it should show, null to leave them out
+    void Encode(const FireCellState& state, const VertexColors* colors, std::vector<uint8_t>& out);
+
+    // True when an image from outside decodes completely within its bytes
+    bool Validate(std::span<const uint8_t> image);
+    uint8_t GetSections(std::span<const uint8_t> image);
+
+    // Writes a valid image into a state freshly built from land, heated and burning vertices become active.
+    // colorsShown tells whether colors already show the delta: the state then takes the delta back out of its original
+    // colors, otherwise colors and the staged colors are darkened and all of them count as changed.
+    // Returns false without touching the state when the image has a color delta but colors is null.
+    bool Decode(std::span<const uint8_t> image, FireCellState& state, VertexColors* colors, bool colorsShown);
+
+    // Darkens freshly loaded land colors by the delta of a valid image, false when that changed nothing
+    bool ApplyColors(std::span<const uint8_t> image, VertexColors& colors);
+    // Gives land colors showing the delta of a valid image their original colors back
+    void RevertColors(std::span<const uint8_t> image, VertexColors& colors);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "WildfireCore/Types.h"
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+struct FireCellState;
+
+using CellHandle = std::uintptr_t;  // Opaque host cell, 0 = none
+
+// Cells with loaded land by coordinate, each linked to its registered neighbours.
+// The host attaches and detaches cells as the game loads them, so spatial lookups never have to ask the world.
+// Attach, Detach and the tick run on the same thread, entries and links stay valid in between.
+class CellRegistry {
+public:
+    struct Entry {
+        CellCoord coord;
+        CellHandle handle = 0;
+        FireCellState* state = nullptr;  // Set while the simulation tracks the cell
+        Entry* neighbours[9] = {};       // By (dy + 1) * 3 + dx + 1, the entry itself in the middle
+    };
+
+    // Registers a loaded cell, or updates the handle of a registered one, and links it with its neighbours
+    Entry& Attach(const CellCoord& coord, CellHandle handle);
+    // Unlinks and forgets a cell, returns false when it was not registered
+    bool Detach(const CellCoord& coord);
+    void Clear();
+
+    // nullptr when the cell is not registered
+    Entry* Find(const CellCoord& coord);
+    CellHandle GetHandle(const CellCoord& coord) const;
+
+    // Calls func(entry) for every registered cell, in no particular order
+    template <class Func>
+    void ForEach(Func&& func) const {
+        std::shared_lock lock(mutex);
+        for (const auto& [coord, entry] : entries) {
+            func(static_cast<const Entry&>(*entry));
+        }
+    }
+
+private:
+    mutable std::shared_mutex mutex;
+    std::unordered_map<CellCoord, std::unique_ptr<Entry>> entries;
+};
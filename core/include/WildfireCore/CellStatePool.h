@@ -0,0 +1,51 @@
+#pragma once
+
+#include "WildfireCore/FireCellState.h"
+
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <queue>
+#include <utility>
+#include <vector>
+
+using CellStateHandle = uint32_t;
+
+// Storage for FireCellState, allocated a slab of cache line aligned blocks at a time and never given back while
+// the pool lives. Released blocks are reused lowest slot first, so live states stay packed in the first slabs and
+// a long session doesn't scatter 46 KB allocations over the heap.
+// A handle, and the pointer it resolves to, stay valid until the state is released. Not thread safe.
+class CellStatePool {
+public:
+    static constexpr CellStateHandle SlabSize = 16;  // States per slab
+
+    CellStatePool() = default;
+    ~CellStatePool();
+
+    CellStatePool(const CellStatePool&) = delete;
+    CellStatePool& operator=(const CellStatePool&) = delete;
+
+    // Constructs a state in a free block
+    template <class... Args>
+    CellStateHandle Acquire(Args&&... args) {
+        CellStateHandle handle = AllocateSlot();
+        new (Get(handle)) FireCellState(std::forward<Args>(args)...);
+        return handle;
+    }
+
+    // Destroys the state and recycles its block
+    void Release(CellStateHandle handle);
+
+    FireCellState* Get(CellStateHandle handle) const { return slabs[handle / SlabSize] + handle % SlabSize; }
+
+    size_t GetLiveCount() const { return liveCount; }
+    size_t GetCapacity() const { return slabs.size() * SlabSize; }
+
+private:
+    CellStateHandle AllocateSlot();
+
+    std::vector<FireCellState*> slabs;
+    std::vector<bool> live;
+    std::priority_queue<CellStateHandle, std::vector<CellStateHandle>, std::greater<>> freeSlots;
+    size_t liveCount = 0;
+};
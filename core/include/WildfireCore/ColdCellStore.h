@@ -0,0 +1,70 @@
+#pragma once
+
+#include "WildfireCore/CellImage.h"
+
+#include <cstdint>
+#include <list>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// Cells packed away from the simulation as CellImages, settled ones and the ones read from a save.
+// A singed cell shrinks from a 46 KB live state to a few hundred bytes.
+// Records are kept in least recently used order so the store can be held under a budget.
+// Not thread safe, FireSimulation guards it with its map lock.
+class ColdCellStore {
+public:
+    // Packs a cell with its staged colors. colorsShown tells whether the loaded land shows them.
+    void Store(const CellCoord& cell, const FireCellState& state, bool colorsShown);
+    // Keeps an already encoded, valid image. colorsShown tells whether the loaded land shows its color delta,
+    // false for images read from a save.
+    void Insert(const CellCoord& cell, std::vector<uint8_t> image, bool colorsShown);
+
+    // Moves the record of the cell into a state freshly built from its land. False when there is none, or when it
+    // holds a color delta and colors is null, the record is then kept.
+    // Land colors that don't show the record yet are darkened again and all of them count as changed.
+    bool Restore(const CellCoord& cell, FireCellState& state, VertexColors* colors);
+
+    // Darkens freshly loaded land colors like they were when the cell was packed, false when nothing changed
+    bool ApplyColors(const CellCoord& cell, VertexColors* colors);
+    // The land of the cell got unloaded, the game reloads it with its original colors
+    void ForgetColors(const CellCoord& cell);
+    // Forgets the record of the cell without restoring it. Land colors showing its delta get their original colors
+    // back, colors are the land colors of the cell or null when its land is gone.
+    void Drop(const CellCoord& cell, VertexColors* colors);
+
+    bool Contains(const CellCoord& cell) const { return records.contains(cell); }
+    // True when the cell was packed with heat or fire left, it has to go back to the simulation once attached
+    bool HasFire(const CellCoord& cell) const;
+    void Clear();
+
+    // Forgets least recently used records until the store fits in budgetBytes, returns how many were dropped
+    size_t Trim(size_t budgetBytes);
+
+    // Calls func(cell, image) for every record, most recently used first
+    template <class Func>
+    void ForEach(Func&& func) const {
+        for (const auto& cell : lru) {
+            func(cell, std::span<const uint8_t>(records.at(cell).image));
+        }
+    }
+
+    std::vector<CellCoord> GetCells() const { return {lru.begin(), lru.end()}; }
+    size_t GetCount() const { return records.size(); }
+    size_t GetBytes() const { return bytes; }
+
+private:
+    struct Record {
+        std::vector<uint8_t> image;
+        bool colorsApplied;  // The loaded land shows the color delta
+        std::list<CellCoord>::iterator lru;
+    };
+
+    void Add(const CellCoord& cell, std::vector<uint8_t> image, bool colorsApplied);
+    static size_t GetFootprint(const Record& record);
+    void Erase(std::unordered_map<CellCoord, Record>::iterator it);
+
+    std::unordered_map<CellCoord, Record> records;
+    std::list<CellCoord> lru;  // Most recently used first
+    size_t bytes = 0;
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "WildfireCore/CellGrid.h"
+#include "WildfireCore/LandProvider.h"
+#include "WildfireCore/SimSettings.h"
+#include "WildfireCore/TextureFuelTable.h"
+#include "WildfireCore/ThreadPool.h"
+
+#include <algorithm>
+#include <bit>
+
+// Bit set over the vertices of a cell grid, one word per row
+struct VertexSet {
+    uint64_t rows[CellGrid::Size] = {};
+
+    void Set(int row, int col) { rows[row] |= uint64_t{1} << col; }
+    bool Test(int row, int col) const { return (rows[row] >> col) & 1; }
+
+    bool Empty() const {
+        for (auto row : rows) {
+            if (row) return false;
+        }
+        return true;
+    }
+
+    // Calls func(row, col) for every vertex in the set, in row-major order
+    template <class Func>
+    void ForEach(Func&& func) const {
+        for (int row = 0; row < CellGrid::Size; ++row) {
+            for (uint64_t bits = rows[row]; bits; bits &= bits - 1) {
+                func(row, std::countr_zero(bits));
+            }
+        }
+    }
+};
+
+// Live state of a tracked cell, about 46 KB. The tick works on float buffers rather than the CompactFireCell layout:
+// the burn kernels run 8 float lanes per instruction, and the default heat loss per tick and the heat a weakly
+// burning neighbour spreads are below one fixed point step, so 16 bit buffers would round them away. Memory is saved
+// around the tick instead: only cells with fire stay live, settled ones are packed into ColdCellStore, snapshots are
+// compact copies.
+struct alignas(CellGrid::Alignment) FireCellState {
+    // Everything the periodic update changes. Updates read the current buffer and write the next one,
+    // so a tick never observes its own partial results.
+    // Fields are CellGrid layouts, the ghost ring of the current buffer is refreshed from the neighbours every tick.
+    struct Buffer {
+        alignas(CellGrid::Alignment) float heat[CellGrid::Cells];
+        alignas(CellGrid::Alignment) float fuel[CellGrid::Cells];
+        alignas(CellGrid::Alignment) bool isBurning[CellGrid::Cells];
+        alignas(CellGrid::Alignment) bool isCharred[CellGrid::Cells];
+    };
+
+    Buffer buffers[2];
+    alignas(CellGrid::Alignment) uint8_t minBurnHeat[CellGrid::Cells];  // Grass configs store it as a byte
+    alignas(CellGrid::Alignment) bool hasLand[CellGrid::Cells];  // Ghost ring entries are false where no land is loaded
+    alignas(CellGrid::Alignment) float height[CellGrid::Cells];  // Land height of the vertices, read once from LAND
+    uint8_t originalColors[4][289][3];  // Original colors for each vertex
+    // Colors the fire gave the land, the simulation only ever writes here. The main thread commits them to the land
+    // once per tick, see FireSimulation::CommitColors.
+    VertexColors stagedColors;
+    VertexSet stagedVertices;  // Vertices whose staged color may differ from the land
+    VertexSet canBurn;
+    VertexSet active;   // Burning, heated or just damaged vertices, the cell sleeps while this is empty
+    uint8_t front = 0;       // Index of the current buffer
+    uint16_t idleTicks = 0;  // Ticks in a row the cell spent settled, without heat or fire
+    bool dirty = true;  // Changed since its CellImage was last encoded
+    // Vertices per CellGrid tile whose land color changed since the cell was last reported altered, saturating
+    uint8_t tileChanges[CellGrid::Tiles] = {};
+
+    // Brightness steps the fire darkens the land in. A staged color is committed once it is a full step away from
+    // the land color, smaller changes wait until they add up or the cell settles.
+    static constexpr int ColorLevels = 8;
+    static constexpr int ColorStep = 256 / ColorLevels;
+    static uint8_t QuantizeGray(uint8_t value) {
+        return static_cast<uint8_t>(std::min((value + ColorStep / 2) / ColorStep * ColorStep, 255));
+    }
+
+    // Grass configs come from the shared fuel table, each combination of covering layers is resolved once.
+    // Every quadrant is evaluated by its own pool task.
+    FireCellState(LandProvider& land, const CellCoord& cell, const SimSettings& settings, TextureFuelTable& fuelTable,
+                  ThreadPool& pool);
+
+    Buffer& Current() { return buffers[front]; }
+    const Buffer& Current() const { return buffers[front]; }
+    Buffer& Next() { return buffers[front ^ 1]; }
+
+    // Makes the next buffer current
+    void Flip() {
+        front ^= 1;
+        dirty = true;
+    }
+
+    // Counts a committed color change of vertex (row, col)
+    void MarkColorChange(int row, int col) {
+        auto& changes = tileChanges[CellGrid::Tile(row, col)];
+        if (changes < UINT8_MAX) {
+            ++changes;
+        }
+    }
+    // The whole land got new colors, like when reloaded from cold storage
+    void MarkAllColorsChanged() { std::fill(std::begin(tileChanges), std::end(tileChanges), UINT8_MAX); }
+    void ClearColorChanges() { std::fill(std::begin(tileChanges), std::end(tileChanges), uint8_t{0}); }
+
+    // Visible color changes counted since the last report, and the tiles holding them as bit Tile(row, col)
+    int GetColorChanges() const;
+    uint16_t GetDirtyTiles() const;
+};
+
+// Vertex state of a cell without the tick's working buffers, for snapshots and anything kept outside the tick:
+// GetFireCellMap, MCP, and the CellImage of packed and saved cells, which stores these steps and decodes them back.
+// The tick itself never uses it and the live state keeps its size, see FireCellState.
+// Heat and fuel are 16 bit fixed point and flags are bit sets, a copy takes about 6 KB instead of 46 KB.
+// Values round to the nearest step, but a vertex with any heat or fuel keeps at least one step of it.
+struct CompactFireCell {
+    static constexpr int Vertices = CellGrid::Size * CellGrid::Size;
+    static constexpr float HeatScale = 8.0f;   // Steps per unit of heat, -4096 to 4096
+    static constexpr float FuelScale = 64.0f;  // Steps per unit of fuel, 0 to 1024
+
+    int16_t heat[Vertices];
+    uint16_t fuel[Vertices];
+    uint8_t minBurnHeat[Vertices];
+    VertexSet burning;
+    VertexSet charred;
+    VertexSet canBurn;
+
+    // Copies the current buffer of a live cell
+    explicit CompactFireCell(const FireCellState& state);
+
+    static float HeatOf(int16_t steps) { return steps / HeatScale; }
+    static float FuelOf(uint16_t steps) { return steps / FuelScale; }
+
+    float Heat(int row, int col) const { return HeatOf(heat[row * CellGrid::Size + col]); }
+    float Fuel(int row, int col) const { return FuelOf(fuel[row * CellGrid::Size + col]); }
+    float MinBurnHeat(int row, int col) const { return minBurnHeat[row * CellGrid::Size + col]; }
+    bool IsBurning(int row, int col) const { return burning.Test(row, col); }
+    bool IsCharred(int row, int col) const { return charred.Test(row, col); }
+    bool CanBurn(int row, int col) const { return canBurn.Test(row, col); }
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "WildfireCore/BurnKernel.h"
+#include "WildfireCore/CellImage.h"
+#include "WildfireCore/CellRegistry.h"
+#include "WildfireCore/CellStatePool.h"
+#include "WildfireCore/ColdCellStore.h"
+#include "WildfireCore/FireCellState.h"
+#include "WildfireCore/ImpactQueue.h"
+#include "WildfireCore/LandProvider.h"
+#include "WildfireCore/SimSettings.h"
+#include "WildfireCore/TextureFuelTable.h"
+#include "WildfireCore/ThreadPool.h"
+
+#include <deque>
+#include <functional>
+#include <optional>
+#include <span>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A cell whose land colors changed visibly
+struct AlteredCell {
+    CellCoord cell;
+    uint16_t dirtyTiles;   // CellGrid tiles holding the changes, bit CellGrid::Tile(row, col)
+    int changedVertices;  // Vertex color level changes, a vertex moving down two levels counts twice
+};
+
+// Heat / fuel spread model over the land vertices.
+// Knows nothing about the game, all world access goes through the LandProvider.
+// Only cells attached to the registry have land, their links replace neighbour lookups in the world.
+// Cells that stay settled for a while are packed into cold storage and rebuilt from it when fire reaches them again.
+// The fire darkens staged copies of the land colors, only PeriodicUpdate writes them to the land.
+class FireSimulation {
+public:
+    FireSimulation(LandProvider& land, const SimSettings& settings, ThreadPool& pool, CellRegistry& cells);
+
+    // Keep the registry in sync with the loaded cells, a detached cell keeps its state until it is reset.
+    // Attaching a packed cell queues it for restoring, see RestorePendingCells.
+    void AttachCell(const CellCoord& cell, CellHandle handle);
+    void DetachCell(const CellCoord& cell);
+
+    // Reads the weather from the land provider. Call it on the thread that owns the game state, once per tick.
+    // Not thread safe, the wind weights are cached between calls.
+    WeatherSnapshot CaptureWeather();
+
+    // Advances the simulation by one tick, cells whose vertex colors changed visibly are appended to alteredCells.
+    // A burning cell is only reported once it gathered MinReportedColorChanges, a settled one with any.
+    // The tick is a pure function of the previous state and the weather: cells are updated in parallel from their
+    // current buffers and the results become visible all at once.
+    void PeriodicUpdate(float delta, const WeatherSnapshot& weather, std::vector<AlteredCell>& alteredCells);
+
+    // Applies an impact right away
+    void AddFireEvent(const WorldPoint& impactPos, float radius, float damage);
+    // Lock free, safe from engine callbacks on any thread. The impact is applied at the start of the next tick,
+    // returns false when too many impacts are already waiting.
+    bool QueueImpact(const ImpactRecord& impact);
+
+    // Compact copies of the tracked cells, packed ones not included
+    std::unordered_map<CellCoord, CompactFireCell> GetFireCellMap();
+    size_t GetColdCellCount();
+    size_t GetColdStorageBytes();
+
+    // Calls write(cell, image) with a CellImage of every cell the fire changed, live and packed ones.
+    // Images are kept between calls, only live cells that changed since are encoded again, in parallel.
+    void CollectCellImages(const std::function<void(const CellCoord&, std::span<const uint8_t>)>& write);
+    // A CellImage read back from a save
+    struct SavedCell {
+        CellCoord cell;
+        std::vector<uint8_t> image;
+    };
+    // Takes the CellImages written by CollectCellImages, meant for a simulation just reset. The images are checked on
+    // the workers and wait packed until their cell is attached. Returns how many decoded.
+    size_t LoadCellImages(std::vector<SavedCell> saved);
+    // Rebuilds up to maxCells attached cells waiting in cold storage, returns how many are still waiting.
+    // Restored land is darkened again and reported as altered by the next update. PeriodicUpdate restores a few
+    // every tick, so the colors and grass of a loaded save come back over several frames.
+    size_t RestorePendingCells(size_t maxCells);
+
+    // Forgets the fire of a cell, live or packed, and gives its land the original colors back
+    void ResetFireCellState(const CellCoord& cell);
+    void ResetAllFireCells();
+
+    // Vertex position on the ground plane, z is 0. Enough for distances and grid keys.
+    static WorldPoint GetVertexPosition2D(const FireVertex& vertex);
+    // Land height interpolated from the cached vertex heights, nullopt when the cell is not tracked
+    std::optional<float> GetCachedHeight(float worldX, float worldY);
+    // Same in the given worldspace, without asking the land provider, so any thread may call it
+    std::optional<float> GetCachedHeight(uint32_t worldSpace, float worldX, float worldY);
+
+    // Name of the burn kernel picked for this CPU
+    const char* GetKernelName() const { return kernel.name; }
+
+    // Called when a vertex starts burning, with the expected burn time in seconds
+    std::function<void(const FireVertex&, float)> OnVertexIgnited;
+
+private:
+    struct Ignition {
+        FireVertex vertex;
+        float lifetime;
+    };
+
+    // A cell taking part in the current tick
+    struct CellTick {
+        CellCoord cell;
+        FireCellState* state;
+        VertexColors* colors;
+        const FireCellState* around[9];  // Neighbouring states by (dy + 1) * 3 + dx + 1, null where there is none
+        bool landAround[9];
+        std::vector<Ignition> ignitions;
+    };
+
+    // Burns the vertices of one cell from its current buffer into its next buffer. Every vertex pulls the heat its
+    // burning neighbours spread, so a cell only ever writes to itself.
+    void UpdateCell(CellTick& work, const BurnParams& params);
+
+    // Adds heat to a grid vertex of the given buffer, returns true when the vertex starts burning.
+    // hits is the number of heat sources combined into damage, each one darkens vertices that can't burn.
+    // Nothing happens without land. Colors only change in the staging buffer of the state.
+    bool ApplyDamage(FireCellState& cellState, FireCellState::Buffer& buffer, bool hasLand, int row, int col,
+                     float damage, bool mgr, int hits = 1);
+    // Removes heat from a grid vertex of the given buffer, a burning vertex left without heat goes out
+    void ApplyCooling(FireCellState& cellState, FireCellState::Buffer& buffer, int row, int col, float amount);
+
+    // Heat on its way to one vertex. Impacts collected in the same batch add up per vertex, so a flame spell hitting
+    // the same spot many times per tick costs one update and at most one ignition there.
+    struct PendingHeat {
+        FireCellState* state;
+        CellCoord cell;
+        int row, col;
+        float amount;  // Net heat, negative for cooling
+        int hits;      // Impacts merged into amount
+        bool hasLand;
+    };
+
+    struct PendingKey {
+        const FireCellState* state;
+        int index;
+        bool operator==(const PendingKey& other) const noexcept {
+            return state == other.state && index == other.index;
+        }
+    };
+
+    struct PendingKeyHash {
+        std::size_t operator()(const PendingKey& key) const noexcept {
+            return std::hash<const void*>()(key.state) ^ (static_cast<std::size_t>(key.index) * 0x9e3779b9);
+        }
+    };
+
+    // Collects the heat an impact brings to the vertices it reaches. Callers hold fireCellMapMutex.
+    void CollectImpact(const WorldPoint& impactPos, float radius, float damage);
+    // Radius impacts: damage falls off linearly with the ground distance to the impact. The vertex range of every
+    // grid row inside the disc is computed directly, so any radius only touches the vertices it covers.
+    // Seam vertices are hit once per registered cell storing them.
+    void CollectDisc(const WorldPoint& center, float radius, float damage);
+    void AddPendingHeat(FireCellState* state, bool hasLand, const CellCoord& cell, int row, int col, float amount);
+    // Applies the merged heat of every collected vertex in collection order and empties the batch
+    void ApplyPendingHeat(std::vector<Ignition>& ignitions);
+    // Writes the staged colors of a cell to its land colors, on the thread that owns them. Only vertices a color step
+    // away from the land are written, the rest wait unless the cell settled. Written vertices count as changed.
+    void CommitColors(FireCellState& state, VertexColors& colors, bool settled);
+    // Appends the cell to alteredCells when its color changes are due and starts counting anew
+    void ReportColorChanges(const CellCoord& cell, FireCellState& state, bool settled,
+                            std::vector<AlteredCell>& alteredCells);
+    // Calls OnVertexIgnited for each ignition, without holding fireCellMapMutex
+    void ReportIgnitions(const std::vector<Ignition>& ignitions);
+
+    // A packed cell has land again: heat and fire go back to the simulation, settled cells only get their colors back
+    void ReviveColdCell(const CellCoord& cell);
+    size_t RestorePendingCellsLocked(size_t maxCells);
+    void ResetFireCellStateLocked(const CellCoord& cell);
+
+    // Get or create a FireCellState for the given cell, packed cells are restored. Null when the land has no colors.
+    FireCellState* GetOrCreateFireCellStateLocked(const CellCoord& cell);
+
+    // Vertex-related methods
+    std::optional<FireVertex> FindNearestVertex(const WorldPoint& pos);
+
+    // Spread weights for one wind, they only change with the wind and WindSpeedFactor
+    struct WindWeights {
+        WindData wind;
+        float windSpeedFactor;
+        float windDirX, windDirY;
+        float weights[8];  // CellGrid::NeighbourOffsets order, rain not applied
+    };
+
+    // Rebuilds the cached weights when the wind or WindSpeedFactor differ from the cached ones
+    const WindWeights& GetWindWeights(WindData wind);
+
+    LandProvider& land;
+    const SimSettings& settings;
+    const BurnKernel& kernel;
+    ThreadPool& pool;
+    CellRegistry& cells;
+    TextureFuelTable fuelTable;
+    std::optional<WindWeights> windWeights;
+
+    ImpactQueue impacts;
+    // Guarded by fireCellMapMutex, kept between batches so the storage is reused
+    std::vector<PendingHeat> pendingHeat;
+    std::unordered_map<PendingKey, size_t, PendingKeyHash> pendingIndex;
+
+    std::shared_mutex fireCellMapMutex;
+    CellStatePool statePool;
+    std::unordered_map<CellCoord, CellStateHandle> fireCellMap;
+    ColdCellStore coldCells;
+    std::deque<CellCoord> pendingRestores;   // Attached cells waiting for their packed state, in attach order
+    std::vector<CellCoord> restoredCells;    // Attached cells whose colors came back from cold storage
+    std::vector<Ignition> restoredIgnitions;  // Burning vertices of restored cells, reported by the next tick
+    std::unordered_map<CellCoord, std::vector<uint8_t>> liveImages;  // Last CellImage of live cells
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "WildfireCore/CellGrid.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// An impact waiting for the next tick, damage is negative for cooling
+struct ImpactRecord {
+    WorldPoint pos;
+    float radius;
+    float damage;
+};
+
+// Bounded lock-free queue of impacts: any number of threads push, the tick is the only consumer.
+// Every slot carries a sequence number telling producers and the consumer whose turn it is, so a push is a single
+// compare-exchange and never waits for the tick. A full queue rejects the impact instead of blocking.
+class ImpactQueue {
+public:
+    static constexpr size_t Capacity = 4096;  // Power of two
+
+    ImpactQueue();
+
+    ImpactQueue(const ImpactQueue&) = delete;
+    ImpactQueue& operator=(const ImpactQueue&) = delete;
+
+    // Safe from any thread, returns false when the queue is full
+    bool Push(const ImpactRecord& record);
+
+    // Consumer only. Calls func(record) for every queued impact in push order, returns the count.
+    template <class Func>
+    size_t Drain(Func&& func) {
+        size_t count = 0;
+        for (;; ++head, ++count) {
+            Slot& slot = slots[head & (Capacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+                return count;  // Empty, or the producer of this slot is still writing
+            }
+            func(static_cast<const ImpactRecord&>(slot.record));
+            slot.sequence.store(head + Capacity, std::memory_order_release);
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        ImpactRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(CellGrid::Alignment) std::atomic<size_t> tail = 0;  // Next position producers claim
+    alignas(CellGrid::Alignment) size_t head = 0;               // Next position the consumer reads
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "WildfireCore/Types.h"
+
+#include <optional>
+#include <vector>
+
+using TextureId = std::uintptr_t;  // Opaque land texture handle, 0 = no texture
+using VertexColors = uint8_t[4][VertsPerQuad][3];
+using VertexHeights = float[4][VertsPerQuad];  // World height of each vertex
+
+struct LandTextureLayers {
+    float percents[4][VertsPerQuad][6];  // Coverage of each texture layer, 0..1
+    TextureId quadTextures[4][6];
+    TextureId defQuadTextures[4];
+};
+
+// Everything the simulation needs to know about the world.
+// The SKSE plugin implements it on top of RE::TES / RE::Sky, SyntheticLand keeps an in-memory terrain.
+class LandProvider {
+public:
+    virtual ~LandProvider() = default;
+
+    // Cell grid
+    virtual std::optional<CellCoord> GetCellAt(float worldX, float worldY) = 0;
+    virtual bool HasLand(const CellCoord& cell) = 0;
+
+    // Vertex data, nullptr / false when the cell has no loaded land
+    virtual VertexColors* GetVertexColors(const CellCoord& cell) = 0;
+    virtual bool GetTextureLayers(const CellCoord& cell, LandTextureLayers& out) = 0;
+    virtual bool GetVertexHeights(const CellCoord& cell, VertexHeights& out) = 0;
+    virtual float GetLandHeight(float worldX, float worldY) = 0;  // Slow path, prefer the heights cached per cell
+
+    // Grass configs matching the grass of a land texture, in evaluation order
+    virtual void GetTextureGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out) = 0;
+
+    // Weather
+    virtual WindData GetCurrentWind() = 0;
+    virtual bool IsCurrentWeatherRaining() = 0;
+};
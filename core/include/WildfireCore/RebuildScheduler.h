@@ -0,0 +1,49 @@
+#pragma once
+
+#include "WildfireCore/CellGrid.h"
+#include "WildfireCore/Types.h"
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+// Cells waiting for the host to rebuild something expensive from their land, like grass.
+// A cell is queued once however often it is requested, repeat requests add to its weight and dirty tiles. Cells come
+// out most visible change first: changed tiles close to the camera and in front of it, changed a lot, waiting long.
+// Not thread safe.
+class RebuildScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Where the player looks from. forward is the horizontal view direction, normalized, zero when unknown.
+    struct View {
+        WorldPoint camera;
+        float forwardX = 0.0f;
+        float forwardY = 0.0f;
+    };
+
+    static constexpr uint16_t AllTiles = UINT16_MAX;
+
+    // Queues the cell, or adds to its waiting request. weight tells how much of the cell changed visibly, tiles where,
+    // as bits CellGrid::Tile(row, col).
+    void Request(const CellCoord& cell, float weight = 1.0f, uint16_t tiles = AllTiles);
+    // Takes the most urgent cell out, nullopt when none waits. One now per frame keeps the ranking consistent.
+    std::optional<CellCoord> Pop(const View& view, Clock::time_point now);
+    void Remove(const CellCoord& cell) { requests.erase(cell); }
+    void Clear() { requests.clear(); }
+
+    bool Empty() const { return requests.empty(); }
+    size_t GetCount() const { return requests.size(); }
+
+    // Urgency of a request, higher goes first. The nearest dirty tile decides how visible the change is.
+    static float GetPriority(const CellCoord& cell, uint16_t tiles, float weight, float waitSeconds, const View& view);
+
+private:
+    struct Pending {
+        float weight;
+        uint16_t tiles;
+        Clock::time_point since;  // First request since the last rebuild
+    };
+
+    std::unordered_map<CellCoord, Pending> requests;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+// Tunables read by the fire simulation.
+// The plugin's Settings derives from this so the MCP sliders keep editing the same fields.
+struct SimSettings {
+    float DefaultMinHeatToBurn = 25.0f;      // Minimum heat required for a cell to start burning
+    float DefaultInitialFuelAmount = 50.0f;  // Initial fuel amount for each vertex
+    float HeatDistributionFactor = 10.0f;    // Heat distribution factor for fire spread
+    float FuelConsumptionRate = 3.0f;        // Rate at which fuel is consumed per second
+    float FuelToHeatRate = 0.50f;            // Rate at which fuel contributes to heat generation
+    float SelfHeatLoss = 0.10f;              // Heat loss per second for non-burning cells
+    float RainingFactor = 0.75f;             // Factor to reduce fire spread when raining
+    float WindSpeedFactor = 2.0f;            // Factor to influence fire spread based on wind speed
+    float ColdStorageBudgetMB = 16.0f;       // Memory for packed settled cells, least recently used ones go first
+    float MinReportedColorChanges = 16.0f;   // Vertex color level changes a burning cell gathers before it is reported
+};
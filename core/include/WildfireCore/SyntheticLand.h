@@ -0,0 +1,52 @@
+#pragma once
+
+#include "WildfireCore/LandProvider.h"
+
+#include <memory>
+#include <unordered_map>
+
+// In-memory terrain for running the simulation without the game.
+// Generates a square block of cells with a deterministic mix of burnable grass and bare ground.
+class SyntheticLand : public LandProvider {
+public:
+    static constexpr uint32_t WorldSpace = 0x3C;  // Tamriel, so coordinates look familiar in logs
+
+    SyntheticLand(int cellsPerSide, uint32_t seed = 1, float grassCoverage = 0.8f);
+
+    std::optional<CellCoord> GetCellAt(float worldX, float worldY) override;
+    bool HasLand(const CellCoord& cell) override;
+
+    VertexColors* GetVertexColors(const CellCoord& cell) override;
+    bool GetTextureLayers(const CellCoord& cell, LandTextureLayers& out) override;
+    bool GetVertexHeights(const CellCoord& cell, VertexHeights& out) override;
+    float GetLandHeight(float worldX, float worldY) override;
+
+    void GetTextureGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out) override;
+
+    WindData GetCurrentWind() override { return wind; }
+    bool IsCurrentWeatherRaining() override { return raining; }
+
+    // Cell range is [minCell, minCell + cellsPerSide) on both axes
+    int GetMinCell() const { return minCell; }
+    int GetCellsPerSide() const { return cellsPerSide; }
+
+    WindData wind{0, 0};
+    bool raining = false;
+
+private:
+    enum Texture : TextureId {
+        kNone,
+        kDirt,
+        kGrass,
+        kDryGrass,
+    };
+
+    struct Cell {
+        VertexColors colors;
+        LandTextureLayers layers;
+    };
+
+    int cellsPerSide;
+    int minCell;
+    std::unordered_map<CellCoord, std::unique_ptr<Cell>> cells;
+};
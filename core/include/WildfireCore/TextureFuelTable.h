@@ -0,0 +1,23 @@
+#pragma once
+
+#include "WildfireCore/LandProvider.h"
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+// Grass configs matching each land texture, asked from the land provider once per texture and session.
+// Filled lazily, safe to use from any thread.
+class TextureFuelTable {
+public:
+    explicit TextureFuelTable(LandProvider& land) : land(land) {}
+
+    // Same result as LandProvider::GetTextureGrassConfigs
+    void GetGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out);
+
+private:
+    LandProvider& land;
+
+    std::shared_mutex mutex;
+    std::unordered_map<TextureId, std::vector<GrassFireConfig>> configs;
+};
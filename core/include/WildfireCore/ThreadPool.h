@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that live as long as the pool.
+// Every worker owns a task queue: it takes its own newest task first and steals the oldest task of another queue
+// when its own runs dry. Tasks must not throw.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned workerCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Worker count that leaves reservedThreads hardware threads to the host application, at least one
+    static unsigned WorkersFor(unsigned reservedThreads);
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    // Queues a task, called from a worker it lands in that worker's own queue
+    void Submit(std::function<void()> task);
+
+    // Runs body(0) .. body(count - 1) on the pool and returns once all of them finished.
+    // The calling thread runs queued tasks while it waits, so calling this from inside a task is fine. Once nothing
+    // is left to take it sleeps until the chunks running on other threads are done.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Runs one task, preferring the given queue. Returns false when every queue was empty.
+    bool TryRunTask(size_t preferred);
+    void WorkerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue = 0;  // Round robin for tasks from outside the pool
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued = 0;
+    bool stopping = false;
+};
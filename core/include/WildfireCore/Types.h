@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Land layout shared by the engine and the simulation:
+// a cell is 4096 units wide and split into 4 quadrants of 17x17 vertices spaced 128 units apart.
+constexpr float CellWorldSize = 4096.0f;
+constexpr float QuadrantWorldSize = 2048.0f;
+constexpr float VertexSpacing = 128.0f;
+constexpr int VertsPerQuadRow = 17;
+constexpr int VertsPerQuad = 289;
+
+struct GrassFireConfig {
+    std::string name;
+    bool canBurn;
+    uint8_t fuel;
+    uint8_t minBurnHeat;
+};
+
+struct WindData {
+    uint8_t speed;
+    uint8_t direction;
+};
+
+// Weather as seen by one tick, captured once by FireSimulation::CaptureWeather
+struct WeatherSnapshot {
+    bool raining;
+    float rainFactor;          // RainingFactor while raining, 1 otherwise
+    WindData wind;
+    float windDirX, windDirY;  // Unit vector the wind blows towards
+    float spreadWeights[8];    // Share of spread heat per direction with wind and rain applied, never negative.
+                               // Ordered NW, N, NE, W, E, SW, S, SE like CellGrid::NeighbourOffsets
+};
+
+struct WorldPoint {
+    float x, y, z;
+
+    float GetDistance(const WorldPoint& other) const {
+        const float dx = x - other.x;
+        const float dy = y - other.y;
+        const float dz = z - other.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Distance on the ground plane, heights ignored
+    float GetDistance2D(const WorldPoint& other) const {
+        const float dx = x - other.x;
+        const float dy = y - other.y;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+struct CellCoord {
+    uint32_t worldSpace;  // FormID of the worldspace the cell belongs to
+    int x, y;
+    bool operator==(const CellCoord& other) const noexcept {
+        return worldSpace == other.worldSpace && x == other.x && y == other.y;
+    }
+};
+
+struct FireVertex {
+    CellCoord cell;  // Coordinates of the cell containing this vertex
+    int quadrant;    // 0-3
+    int vertex;      // 0-288
+};
+
+namespace std {
+    template <>
+    struct hash<CellCoord> {
+        std::size_t operator()(const CellCoord& coord) const noexcept {
+            std::size_t h1 = std::hash<int>()(coord.x);
+            std::size_t h2 = std::hash<int>()(coord.y);
+            std::size_t h = h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+            return h ^ (std::hash<uint32_t>()(coord.worldSpace) + 0x9e3779b9 + (h << 6) + (h >> 2));
+        }
+    };
+}
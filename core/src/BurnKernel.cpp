@@ -0,0 +1,93 @@
+#include "WildfireCore/BurnKernel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+#if defined(WILDFIRE_AVX2_KERNEL) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#ifdef WILDFIRE_AVX2_KERNEL
+// BurnKernelAvx2.cpp, only built for x64 and only called when the CPU supports it
+void BurnRowAvx2(const FireCellState& state, FireCellState::Buffer& next, int row, uint64_t columns,
+                 const BurnParams& params, float* incoming, int32_t* hits);
+#endif
+
+namespace {
+    // Reference implementation, the SIMD kernels follow its operation order exactly
+    void BurnRowScalar(const FireCellState& state, FireCellState::Buffer& next, int row, uint64_t columns,
+                       const BurnParams& params, float* incoming, int32_t* hits) {
+        const auto& current = state.Current();
+        for (; columns; columns &= columns - 1) {
+            const int i = CellGrid::Index(row, std::countr_zero(columns));
+            const float heat = current.heat[i];
+
+            if (current.isBurning[i]) {
+                float neighbours = 0.0f;
+                for (int offset : CellGrid::NeighbourOffsets) {
+                    neighbours += state.hasLand[i + offset] ? 1.0f : 0.0f;
+                }
+                // Spread heat, burn fuel and gain heat from it
+                const float fuel = current.fuel[i] - params.fuelBurn;
+                next.heat[i] = heat - neighbours * (heat * params.spreadScale) + params.heatGain;
+                next.fuel[i] = fuel;
+                // Charred when burning stops
+                if (fuel <= 0.0f) {
+                    next.isBurning[i] = false;
+                    next.isCharred[i] = true;
+                }
+            } else if (heat > 0.0f) {
+                // Cool down if not burning
+                next.heat[i] = heat - params.selfHeatLoss;
+            }
+
+            // Pull from burning neighbours, only positive shares count
+            float pulled = 0.0f;
+            int32_t sources = 0;
+            for (int d = 0; d < 8; ++d) {
+                const int n = i + CellGrid::NeighbourOffsets[d];
+                const float share =
+                    std::max(current.isBurning[n] ? current.heat[n] * params.spreadWeights[7 - d] : 0.0f, 0.0f);
+                pulled += share;
+                sources += share > 0.0f ? 1 : 0;
+            }
+            incoming[i] = pulled;
+            hits[i] = sources;
+        }
+    }
+
+    bool CpuSupportsAvx2() {
+#if !defined(WILDFIRE_AVX2_KERNEL)
+        return false;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool osxsave = info[2] & (1 << 27);
+        const bool avx = info[2] & (1 << 28);
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;  // OS must save the YMM registers
+        __cpuidex(info, 7, 0);
+        return info[1] & (1 << 5);
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    const BurnKernel& SelectBurnKernel() {
+        static const BurnKernel scalar{"scalar", BurnRowScalar};
+#ifdef WILDFIRE_AVX2_KERNEL
+        static const BurnKernel avx2{"avx2", BurnRowAvx2};
+        if (!std::getenv("WILDFIRE_SCALAR_KERNEL") && CpuSupportsAvx2()) {
+            return avx2;
+        }
+#endif
+        return scalar;
+    }
+}
+
+const BurnKernel& GetBurnKernel() {
+    static const BurnKernel& kernel = SelectBurnKernel();
+    return kernel;
+}
@@ -0,0 +1,84 @@
+// Built with AVX2 code generation, see core/CMakeLists.txt. Nothing in here may run before the CPU check.
+#include "WildfireCore/BurnKernel.h"
+
+#include <immintrin.h>
+
+namespace {
+    // 8 bools to a lane mask
+    __m256 LoadFlags(const bool* flags) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags));
+        return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(bytes), _mm256_setzero_si256()));
+    }
+
+    __m256 LaneMask(unsigned bits) {
+        const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        __m256i set = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), lanes);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(set, lanes));
+    }
+}
+
+// Same operation order as BurnRowScalar, 8 columns at a time. Blocks start at the ghost column so they stay aligned.
+void BurnRowAvx2(const FireCellState& state, FireCellState::Buffer& next, int row, uint64_t columns,
+                 const BurnParams& params, float* incoming, int32_t* hits) {
+    const auto& current = state.Current();
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 spreadScale = _mm256_set1_ps(params.spreadScale);
+    const __m256 fuelBurn = _mm256_set1_ps(params.fuelBurn);
+    const __m256 heatGain = _mm256_set1_ps(params.heatGain);
+    const __m256 selfHeatLoss = _mm256_set1_ps(params.selfHeatLoss);
+
+    const uint64_t blockColumns = columns << 1;  // Bit 0 is the ghost column
+    for (int block = 0; block < CellGrid::Stride; block += 8) {
+        const unsigned bits = static_cast<unsigned>(blockColumns >> block) & 0xFF;
+        if (!bits) continue;
+        const int i = CellGrid::Index(row, block - 1);
+        const __m256 lanes = LaneMask(bits);
+
+        const __m256 heat = _mm256_load_ps(current.heat + i);
+        const __m256 fuel = _mm256_load_ps(current.fuel + i);
+        const __m256 burning = LoadFlags(current.isBurning + i);
+
+        // Burning: spread heat, burn fuel and gain heat from it
+        __m256 neighbours = zero;
+        for (int offset : CellGrid::NeighbourOffsets) {
+            neighbours = _mm256_add_ps(neighbours, _mm256_and_ps(LoadFlags(state.hasLand + i + offset), one));
+        }
+        const __m256 burnt = _mm256_sub_ps(fuel, fuelBurn);
+        const __m256 burnHeat = _mm256_add_ps(
+            _mm256_sub_ps(heat, _mm256_mul_ps(neighbours, _mm256_mul_ps(heat, spreadScale))), heatGain);
+        const __m256 charring = _mm256_and_ps(burning, _mm256_cmp_ps(burnt, zero, _CMP_LE_OQ));
+
+        // Not burning: cool down if heated
+        const __m256 cooling = _mm256_andnot_ps(burning, _mm256_cmp_ps(heat, zero, _CMP_GT_OQ));
+        const __m256 coolHeat = _mm256_sub_ps(heat, selfHeatLoss);
+
+        __m256 newHeat = _mm256_blendv_ps(heat, burnHeat, burning);
+        newHeat = _mm256_blendv_ps(newHeat, coolHeat, cooling);
+        const __m256 newFuel = _mm256_blendv_ps(fuel, burnt, burning);
+
+        // Pull from burning neighbours, only positive shares count
+        __m256 pulled = zero;
+        __m256i sources = _mm256_setzero_si256();
+        for (int d = 0; d < 8; ++d) {
+            const int n = i + CellGrid::NeighbourOffsets[d];
+            const __m256 weight = _mm256_set1_ps(params.spreadWeights[7 - d]);
+            __m256 share = _mm256_mul_ps(_mm256_loadu_ps(current.heat + n), weight);
+            share = _mm256_max_ps(_mm256_and_ps(share, LoadFlags(current.isBurning + n)), zero);
+            pulled = _mm256_add_ps(pulled, share);
+            sources = _mm256_sub_epi32(sources, _mm256_castps_si256(_mm256_cmp_ps(share, zero, _CMP_GT_OQ)));
+        }
+
+        _mm256_store_ps(next.heat + i, _mm256_blendv_ps(_mm256_load_ps(next.heat + i), newHeat, lanes));
+        _mm256_store_ps(next.fuel + i, _mm256_blendv_ps(_mm256_load_ps(next.fuel + i), newFuel, lanes));
+        _mm256_store_ps(incoming + i, pulled);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(hits + i), sources);
+
+        const unsigned charred = static_cast<unsigned>(_mm256_movemask_ps(charring)) & bits;
+        for (unsigned lane = charred; lane; lane &= lane - 1) {
+            const int index = i + std::countr_zero(lane);
+            next.isBurning[index] = false;
+            next.isCharred[index] = true;
+        }
+    }
+}
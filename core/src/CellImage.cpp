@@ -0,0 +1,214 @@
+#include "WildfireCore/CellImage.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    constexpr int Vertices = CompactFireCell::Vertices;
+    constexpr int ColorBytes = 4 * VertsPerQuad * 3;
+
+    void WriteVarint(std::vector<uint8_t>& out, uint32_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Reads bounds checked, a truncated or overlong varint leaves the reader failed
+    struct Reader {
+        const uint8_t* at;
+        const uint8_t* end;
+        bool failed = false;
+
+        uint32_t Varint() {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                if (at == end) break;
+                uint8_t byte = *at++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            failed = true;
+            return 0;
+        }
+
+        // Runs covering exactly count entries, set(i, value) is called for each entry
+        template <class Set>
+        bool Runs(int count, Set&& set) {
+            for (int i = 0; i < count;) {
+                const uint32_t length = Varint();
+                const uint32_t value = Varint();
+                if (failed || length == 0 || length > static_cast<uint32_t>(count - i)) {
+                    failed = true;
+                    return false;
+                }
+                for (const int runEnd = i + static_cast<int>(length); i < runEnd; ++i) set(i, value);
+            }
+            return true;
+        }
+
+        bool Skip(int count) {
+            return Runs(count, [](int, uint32_t) {});
+        }
+    };
+
+    void WriteRuns(std::vector<uint8_t>& out, const uint32_t* values, int count) {
+        for (int i = 0; i < count;) {
+            const uint32_t value = values[i];
+            int end = i + 1;
+            while (end < count && values[end] == value) ++end;
+            WriteVarint(out, static_cast<uint32_t>(end - i));
+            WriteVarint(out, value);
+            i = end;
+        }
+    }
+
+    uint32_t ZigZag(int16_t value) { return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 15); }
+    int16_t UnZigZag(uint32_t value) { return static_cast<int16_t>((value >> 1) ^ (0u - (value & 1))); }
+
+    int GridIndex(int i) { return CellGrid::Index(i / CellGrid::Size, i % CellGrid::Size); }
+
+    // Color bytes in quadrant, vertex, channel order
+    uint8_t& ColorAt(VertexColors& colors, int i) {
+        return colors[i / (VertsPerQuad * 3)][i / 3 % VertsPerQuad][i % 3];
+    }
+
+    Reader Open(std::span<const uint8_t> image, uint8_t& sections) {
+        Reader in{image.data(), image.data() + image.size()};
+        sections = image.empty() ? 0 : *in.at++;
+        return in;
+    }
+
+    // Moves the reader to the color delta, false when the image has none
+    bool SeekColors(std::span<const uint8_t> image, Reader& in) {
+        uint8_t sections;
+        in = Open(image, sections);
+        if (!(sections & CellImage::HasColors) || !in.Skip(Vertices) || !in.Skip(Vertices)) {
+            return false;
+        }
+        return !(sections & CellImage::HasFire) || (in.Skip(Vertices) && in.Skip(Vertices));
+    }
+}
+
+namespace CellImage {
+    void Encode(const FireCellState& state, const VertexColors* colors, std::vector<uint8_t>& out) {
+        const CompactFireCell compact(state);
+        bool hasFire = false;
+        for (int i = 0; i < Vertices && !hasFire; ++i) {
+            hasFire = compact.heat[i] != 0;
+        }
+        for (int row = 0; row < CellGrid::Size && !hasFire; ++row) {
+            hasFire = compact.burning.rows[row] != 0;
+        }
+
+        out.push_back(static_cast<uint8_t>((hasFire ? HasFire : 0) | (colors ? HasColors : 0)));
+        // Every section is laid out flat first, the runs are then found in one pass
+        uint32_t values[ColorBytes];
+        auto writeMask = [&](const VertexSet& set) {
+            for (int row = 0; row < CellGrid::Size; ++row) {
+                for (int col = 0; col < CellGrid::Size; ++col) {
+                    values[row * CellGrid::Size + col] = (set.rows[row] >> col) & 1;
+                }
+            }
+            WriteRuns(out, values, Vertices);
+        };
+        writeMask(compact.charred);
+        std::copy(std::begin(compact.fuel), std::end(compact.fuel), values);
+        WriteRuns(out, values, Vertices);
+        if (hasFire) {
+            writeMask(compact.burning);
+            std::transform(std::begin(compact.heat), std::end(compact.heat), values, ZigZag);
+            WriteRuns(out, values, Vertices);
+        }
+        if (colors) {
+            const auto* original = &state.originalColors[0][0][0];
+            const auto* shown = &(*colors)[0][0][0];
+            for (int i = 0; i < ColorBytes; ++i) {
+                values[i] = static_cast<uint8_t>(original[i] - shown[i]);
+            }
+            WriteRuns(out, values, ColorBytes);
+        }
+    }
+
+    bool Validate(std::span<const uint8_t> image) {
+        uint8_t sections;
+        Reader in = Open(image, sections);
+        if (image.empty() || (sections & ~(HasFire | HasColors))) {
+            return false;
+        }
+        bool valid = in.Skip(Vertices) && in.Runs(Vertices, [&](int, uint32_t fuel) { in.failed |= fuel > 0xFFFF; });
+        if (sections & HasFire) {
+            valid = valid && in.Skip(Vertices) && in.Runs(Vertices, [&](int, uint32_t heat) {
+                in.failed |= heat > 0xFFFF;
+            });
+        }
+        if (sections & HasColors) {
+            valid = valid && in.Runs(ColorBytes, [&](int, uint32_t delta) { in.failed |= delta > 0xFF; });
+        }
+        return valid && !in.failed && in.at == in.end;
+    }
+
+    uint8_t GetSections(std::span<const uint8_t> image) { return image.empty() ? 0 : image[0]; }
+
+    bool Decode(std::span<const uint8_t> image, FireCellState& state, VertexColors* colors, bool colorsShown) {
+        auto& current = state.Current();
+        uint8_t sections;
+        Reader in = Open(image, sections);
+        if ((sections & HasColors) && !colors) {
+            return false;  // The delta would be lost
+        }
+        in.Runs(Vertices, [&](int i, uint32_t charred) { current.isCharred[GridIndex(i)] = charred != 0; });
+        in.Runs(Vertices, [&](int i, uint32_t fuel) {
+            current.fuel[GridIndex(i)] = CompactFireCell::FuelOf(static_cast<uint16_t>(fuel));
+        });
+        if (sections & HasFire) {
+            in.Runs(Vertices, [&](int i, uint32_t burning) { current.isBurning[GridIndex(i)] = burning != 0; });
+            in.Runs(Vertices, [&](int i, uint32_t heat) {
+                current.heat[GridIndex(i)] = CompactFireCell::HeatOf(UnZigZag(heat));
+            });
+            for (int row = 0; row < CellGrid::Size; ++row) {
+                for (int col = 0; col < CellGrid::Size; ++col) {
+                    const int index = CellGrid::Index(row, col);
+                    if (current.isBurning[index] || current.heat[index] != 0.0f) {
+                        state.active.Set(row, col);
+                    }
+                }
+            }
+        }
+        if (sections & HasColors) {
+            if (colorsShown) {
+                // The state took the darkened land colors as its original ones
+                in.Runs(ColorBytes, [&](int i, uint32_t delta) { ColorAt(state.originalColors, i) += delta; });
+            } else {
+                in.Runs(ColorBytes, [&](int i, uint32_t delta) {
+                    ColorAt(*colors, i) -= delta;
+                    ColorAt(state.stagedColors, i) -= delta;
+                });
+                state.MarkAllColorsChanged();
+            }
+        }
+        state.Next() = current;
+        return true;
+    }
+
+    bool ApplyColors(std::span<const uint8_t> image, VertexColors& colors) {
+        Reader in{};
+        if (!SeekColors(image, in)) {
+            return false;
+        }
+        bool changed = false;
+        in.Runs(ColorBytes, [&](int i, uint32_t delta) {
+            ColorAt(colors, i) -= delta;
+            changed = changed || delta != 0;
+        });
+        return changed;
+    }
+
+    void RevertColors(std::span<const uint8_t> image, VertexColors& colors) {
+        Reader in{};
+        if (SeekColors(image, in)) {
+            in.Runs(ColorBytes, [&](int i, uint32_t delta) { ColorAt(colors, i) += delta; });
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#include "WildfireCore/CellRegistry.h"
+
+CellRegistry::Entry& CellRegistry::Attach(const CellCoord& coord, CellHandle handle) {
+    std::unique_lock lock(mutex);
+    auto& slot = entries[coord];
+    if (!slot) {
+        slot = std::make_unique<Entry>();
+        slot->coord = coord;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                auto it = entries.find(CellCoord{coord.worldSpace, coord.x + dx, coord.y + dy});
+                if (it == entries.end()) continue;
+                // The neighbour at (dx, dy) sees this cell at (-dx, -dy)
+                slot->neighbours[(dy + 1) * 3 + dx + 1] = it->second.get();
+                it->second->neighbours[(1 - dy) * 3 + 1 - dx] = slot.get();
+            }
+        }
+    }
+    slot->handle = handle;
+    return *slot;
+}
+
+bool CellRegistry::Detach(const CellCoord& coord) {
+    std::unique_lock lock(mutex);
+    auto it = entries.find(coord);
+    if (it == entries.end()) {
+        return false;
+    }
+    for (int slot = 0; slot < 9; ++slot) {
+        if (auto* neighbour = it->second->neighbours[slot]) {
+            neighbour->neighbours[8 - slot] = nullptr;
+        }
+    }
+    entries.erase(it);
+    return true;
+}
+
+void CellRegistry::Clear() {
+    std::unique_lock lock(mutex);
+    entries.clear();
+}
+
+CellRegistry::Entry* CellRegistry::Find(const CellCoord& coord) {
+    std::shared_lock lock(mutex);
+    auto it = entries.find(coord);
+    return it != entries.end() ? it->second.get() : nullptr;
+}
+
+CellHandle CellRegistry::GetHandle(const CellCoord& coord) const {
+    std::shared_lock lock(mutex);
+    auto it = entries.find(coord);
+    return it != entries.end() ? it->second->handle : 0;
+}
@@ -0,0 +1,42 @@
+#include "WildfireCore/CellStatePool.h"
+
+namespace {
+    constexpr std::align_val_t SlabAlignment{alignof(FireCellState)};
+}
+
+CellStatePool::~CellStatePool() {
+    for (CellStateHandle handle = 0; handle < live.size(); ++handle) {
+        if (live[handle]) {
+            Get(handle)->~FireCellState();
+        }
+    }
+    for (auto* slab : slabs) {
+        ::operator delete(slab, SlabAlignment);
+    }
+}
+
+void CellStatePool::Release(CellStateHandle handle) {
+    if (!live[handle]) {
+        return;
+    }
+    Get(handle)->~FireCellState();
+    live[handle] = false;
+    freeSlots.push(handle);
+    --liveCount;
+}
+
+CellStateHandle CellStatePool::AllocateSlot() {
+    if (freeSlots.empty()) {
+        auto first = static_cast<CellStateHandle>(GetCapacity());
+        slabs.push_back(static_cast<FireCellState*>(::operator new(sizeof(FireCellState) * SlabSize, SlabAlignment)));
+        live.resize(GetCapacity(), false);
+        for (CellStateHandle handle = first; handle < first + SlabSize; ++handle) {
+            freeSlots.push(handle);
+        }
+    }
+    CellStateHandle handle = freeSlots.top();
+    freeSlots.pop();
+    live[handle] = true;
+    ++liveCount;
+    return handle;
+}
@@ -0,0 +1,93 @@
+#include "WildfireCore/ColdCellStore.h"
+
+void ColdCellStore::Store(const CellCoord& cell, const FireCellState& state, bool colorsShown) {
+    std::vector<uint8_t> image;
+    CellImage::Encode(state, &state.stagedColors, image);
+    Add(cell, std::move(image), colorsShown);
+}
+
+void ColdCellStore::Insert(const CellCoord& cell, std::vector<uint8_t> image, bool colorsShown) {
+    Add(cell, std::move(image), colorsShown);
+}
+
+bool ColdCellStore::Restore(const CellCoord& cell, FireCellState& state, VertexColors* colors) {
+    auto it = records.find(cell);
+    if (it == records.end()) {
+        return false;
+    }
+    if (!CellImage::Decode(it->second.image, state, colors, it->second.colorsApplied)) {
+        return false;  // Kept, the saved darkening needs land colors
+    }
+    Erase(it);
+    return true;
+}
+
+bool ColdCellStore::ApplyColors(const CellCoord& cell, VertexColors* colors) {
+    auto it = records.find(cell);
+    if (it == records.end() || !colors || it->second.colorsApplied) {
+        return false;
+    }
+    Record& record = it->second;
+    lru.splice(lru.begin(), lru, record.lru);
+    record.colorsApplied = true;
+    return CellImage::ApplyColors(record.image, *colors);
+}
+
+void ColdCellStore::ForgetColors(const CellCoord& cell) {
+    if (auto it = records.find(cell); it != records.end()) {
+        it->second.colorsApplied = false;
+    }
+}
+
+void ColdCellStore::Drop(const CellCoord& cell, VertexColors* colors) {
+    auto it = records.find(cell);
+    if (it == records.end()) {
+        return;
+    }
+    if (colors && it->second.colorsApplied) {
+        CellImage::RevertColors(it->second.image, *colors);
+    }
+    Erase(it);
+}
+
+bool ColdCellStore::HasFire(const CellCoord& cell) const {
+    auto it = records.find(cell);
+    return it != records.end() && (CellImage::GetSections(it->second.image) & CellImage::HasFire);
+}
+
+void ColdCellStore::Clear() {
+    records.clear();
+    lru.clear();
+    bytes = 0;
+}
+
+size_t ColdCellStore::Trim(size_t budgetBytes) {
+    size_t dropped = 0;
+    while (bytes > budgetBytes && !lru.empty()) {
+        Erase(records.find(lru.back()));
+        ++dropped;
+    }
+    return dropped;
+}
+
+void ColdCellStore::Add(const CellCoord& cell, std::vector<uint8_t> image, bool colorsApplied) {
+    if (auto it = records.find(cell); it != records.end()) {
+        Erase(it);
+    }
+    image.shrink_to_fit();
+    lru.push_front(cell);
+    Record record{std::move(image), colorsApplied, lru.begin()};
+    bytes += GetFootprint(record);
+    records.emplace(cell, std::move(record));
+}
+
+size_t ColdCellStore::GetFootprint(const Record& record) {
+    // Packed data plus the map node and list entry holding it
+    return record.image.capacity() + sizeof(CellCoord) + sizeof(Record) + 4 * sizeof(void*);
+}
+
+void ColdCellStore::Erase(std::unordered_map<CellCoord, Record>::iterator it) {
+    bytes -= GetFootprint(it->second);
+    lru.erase(it->second.lru);
+    records.erase(it);
+}
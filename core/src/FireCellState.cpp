@@ -0,0 +1,182 @@
+#include "WildfireCore/FireCellState.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+
+namespace {
+    void ApplyTextureGrass(TextureFuelTable& fuelTable, TextureId tex, std::vector<GrassFireConfig>& matches,
+                           bool& canBurn, uint8_t& fuel, uint8_t& minBurnHeat, bool& defaultConfig) {
+        matches.clear();
+        fuelTable.GetGrassConfigs(tex, matches);
+        for (const auto& entry : matches) {
+            if (defaultConfig) {
+                canBurn = entry.canBurn;
+                fuel = entry.fuel;
+                minBurnHeat = entry.minBurnHeat;
+                defaultConfig = false;
+            } else {
+                canBurn = canBurn || entry.canBurn;
+                fuel = (fuel + entry.fuel) / 2;
+                minBurnHeat = (minBurnHeat + entry.minBurnHeat) / 2;
+            }
+        }
+    }
+
+    // Rounds to the nearest step, saturating. Anything non zero stays at least one step away from zero.
+    template <class T>
+    T Quantize(float value, float scale) {
+        constexpr float Low = static_cast<float>(std::numeric_limits<T>::min());
+        constexpr float High = static_cast<float>(std::numeric_limits<T>::max());
+        float steps = std::clamp(std::round(value * scale), Low, High);
+        if (steps == 0.0f && value != 0.0f) {
+            steps = value > 0.0f ? 1.0f : std::max(-1.0f, Low);
+        }
+        return static_cast<T>(steps);
+    }
+
+    // Texture layers covering a vertex: bit i for layer i, DefaultLayerBit for the quadrant's default texture
+    constexpr int DefaultLayerBit = 1 << 6;
+    constexpr int LayerMasks = DefaultLayerBit << 1;
+
+    int GetLayerMask(const LandTextureLayers& layers, int q, int v) {
+        int mask = 0;
+        float defaultTexturePercent = 1.0f;
+        for (int texIdx = 0; texIdx < 6; ++texIdx) {
+            // Check percent coverage
+            float percent = layers.percents[q][v][texIdx];
+            defaultTexturePercent -= percent;
+            if (percent > 0.0f) {
+                mask |= 1 << texIdx;
+            }
+        }
+        if (defaultTexturePercent > 0.0f) {
+            mask |= DefaultLayerBit;
+        }
+        return mask;
+    }
+
+    std::tuple<bool, uint8_t, uint8_t> GetGrassData(TextureFuelTable& fuelTable, const LandTextureLayers& layers,
+                                                    int q, int mask, const SimSettings& settings) {
+        bool canBurn = false;
+        uint8_t fuel = static_cast<uint8_t>(settings.DefaultInitialFuelAmount);
+        uint8_t minBurnHeat = static_cast<uint8_t>(settings.DefaultMinHeatToBurn);
+        bool defaultConfig = true;
+
+        std::vector<GrassFireConfig> matches;
+        for (int texIdx = 0; texIdx < 6; ++texIdx) {
+            if (mask & (1 << texIdx)) {
+                TextureId tex = layers.quadTextures[q][texIdx];
+                if (!tex) continue;
+                ApplyTextureGrass(fuelTable, tex, matches, canBurn, fuel, minBurnHeat, defaultConfig);
+            }
+        }
+        if (mask & DefaultLayerBit) {
+            TextureId tex = layers.defQuadTextures[q];
+            if (!tex) return {canBurn, fuel, minBurnHeat};
+            ApplyTextureGrass(fuelTable, tex, matches, canBurn, fuel, minBurnHeat, defaultConfig);
+        }
+
+        return {canBurn, fuel, minBurnHeat};
+    }
+}
+
+FireCellState::FireCellState(LandProvider& land, const CellCoord& cell, const SimSettings& settings,
+                             TextureFuelTable& fuelTable, ThreadPool& pool) {
+    auto& current = Current();
+    std::memset(current.heat, 0, sizeof(current.heat));
+    std::memset(current.fuel, 0, sizeof(current.fuel));
+    std::memset(current.isBurning, false, sizeof(current.isBurning));
+    std::memset(current.isCharred, false, sizeof(current.isCharred));
+    std::memset(hasLand, false, sizeof(hasLand));
+    std::memset(height, 0, sizeof(height));
+    std::fill(std::begin(minBurnHeat), std::end(minBurnHeat), static_cast<uint8_t>(settings.DefaultMinHeatToBurn));
+
+    auto* colors = land.GetVertexColors(cell);
+    auto layers = std::make_unique<LandTextureLayers>();
+    VertexHeights heights;
+    if (!colors || !land.GetTextureLayers(cell, *layers) || !land.GetVertexHeights(cell, heights)) {
+        // No land loaded, nothing here can ever burn
+        std::memset(originalColors, 0, sizeof(originalColors));
+        std::memset(stagedColors, 0, sizeof(stagedColors));
+    } else {
+        std::memcpy(originalColors, *colors, sizeof(originalColors));
+        std::memcpy(stagedColors, *colors, sizeof(stagedColors));
+
+        // Vertices of a quadrant only differ by the layers covering them, every combination is resolved once.
+        // One task per quadrant: seam vertices belong to the lowest quadrant holding them, so every task writes its
+        // own vertices and resolves its own combinations. Quadrants share grid rows, canBurn is merged afterwards.
+        std::optional<std::tuple<bool, uint8_t, uint8_t>> resolved[4][LayerMasks];
+        VertexSet quadrantCanBurn[4];
+        pool.ParallelFor(4, [&](size_t quadrant) {
+            const int q = static_cast<int>(quadrant);
+            const int firstRow = q / 2 == 0 ? 0 : 17;
+            const int firstCol = q % 2 == 0 ? 0 : 17;
+            for (int row = firstRow; row < firstRow + (firstRow ? 16 : 17); ++row) {
+                for (int col = firstCol; col < firstCol + (firstCol ? 16 : 17); ++col) {
+                    const int v = CellGrid::ToQuadrant(row, col).vertex;
+                    int mask = GetLayerMask(*layers, q, v);
+                    auto& grass = resolved[q][mask];
+                    if (!grass) {
+                        grass = GetGrassData(fuelTable, *layers, q, mask, settings);
+                    }
+                    auto [canBurnValue, fuelValue, minBurnHeatValue] = *grass;
+
+                    int index = CellGrid::Index(row, col);
+                    if (canBurnValue) {
+                        quadrantCanBurn[q].Set(row, col);
+                    }
+                    current.fuel[index] = fuelValue;
+                    minBurnHeat[index] = minBurnHeatValue;
+                    hasLand[index] = true;
+                    height[index] = heights[q][v];
+                }
+            }
+        });
+        for (const auto& quadrantSet : quadrantCanBurn) {
+            for (int row = 0; row < CellGrid::Size; ++row) {
+                canBurn.rows[row] |= quadrantSet.rows[row];
+            }
+        }
+    }
+
+    Next() = current;
+}
+
+int FireCellState::GetColorChanges() const {
+    int changes = 0;
+    for (auto tile : tileChanges) {
+        changes += tile;
+    }
+    return changes;
+}
+
+uint16_t FireCellState::GetDirtyTiles() const {
+    uint16_t tiles = 0;
+    for (int tile = 0; tile < CellGrid::Tiles; ++tile) {
+        if (tileChanges[tile]) {
+            tiles |= static_cast<uint16_t>(1u << tile);
+        }
+    }
+    return tiles;
+}
+
+CompactFireCell::CompactFireCell(const FireCellState& state) {
+    const auto& current = state.Current();
+    canBurn = state.canBurn;
+    for (int row = 0; row < CellGrid::Size; ++row) {
+        for (int col = 0; col < CellGrid::Size; ++col) {
+            const int from = CellGrid::Index(row, col);
+            const int to = row * CellGrid::Size + col;
+            heat[to] = Quantize<int16_t>(current.heat[from], HeatScale);
+            fuel[to] = Quantize<uint16_t>(current.fuel[from], FuelScale);
+            minBurnHeat[to] = state.minBurnHeat[from];
+            if (current.isBurning[from]) burning.Set(row, col);
+            if (current.isCharred[from]) charred.Set(row, col);
+        }
+    }
+}
@@ -0,0 +1,850 @@
+#include "WildfireCore/FireSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+FireSimulation::FireSimulation(LandProvider& land, const SimSettings& settings, ThreadPool& pool,
+                               CellRegistry& cells)
+    : land(land), settings(settings), kernel(GetBurnKernel()), pool(pool), cells(cells), fuelTable(land) {}
+
+namespace {
+    // Ticks a cell stays settled before it is packed, short fire free spells keep the live state
+    constexpr uint16_t EvictAfterIdleTicks = 30;
+    // Settled cells encoded per tick, saves then only encode the burning ones
+    constexpr int ImagesPerTick = 4;
+    // Packed cells rebuilt per tick once attached, each one recolors its land and regrows its grass
+    constexpr size_t RestoresPerTick = 4;
+
+    bool CellLess(const CellCoord& a, const CellCoord& b) {
+        if (a.worldSpace != b.worldSpace) return a.worldSpace < b.worldSpace;
+        if (a.y != b.y) return a.y < b.y;
+        return a.x < b.x;
+    }
+
+    // True when a burning vertex of the cell lies in the ghost ring of its neighbour at (dx, dy).
+    // Cells store their shared edges twice, so the ring of a neighbour reaches one vertex past the edge.
+    bool BurnsTowards(const FireCellState& state, int dx, int dy) {
+        auto range = [](int d, int& first, int& last) {
+            first = d > 0 ? CellGrid::Size - 2 : d < 0 ? 1 : 0;
+            last = d > 0 ? CellGrid::Size - 2 : d < 0 ? 1 : CellGrid::Size - 1;
+        };
+        int firstRow, lastRow, firstCol, lastCol;
+        range(dy, firstRow, lastRow);
+        range(dx, firstCol, lastCol);
+        const auto& current = state.Current();
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int col = firstCol; col <= lastCol; ++col) {
+                if (current.isBurning[CellGrid::Index(row, col)]) return true;
+            }
+        }
+        return false;
+    }
+
+    // Copies the ghost ring of the current buffer from the current buffers of the neighbours
+    void FillGhostRing(FireCellState& state, const FireCellState* const (&around)[9], const bool (&landAround)[9]) {
+        auto& current = state.Current();
+        auto fill = [&](int row, int col) {
+            int dy = row < 0 ? -1 : row >= CellGrid::Size ? 1 : 0;
+            int dx = col < 0 ? -1 : col >= CellGrid::Size ? 1 : 0;
+            int slot = (dy + 1) * 3 + dx + 1;
+            int index = CellGrid::Index(row, col);
+            state.hasLand[index] = landAround[slot];
+            if (const auto* source = around[slot]; source && landAround[slot]) {
+                int sourceIndex = CellGrid::Index(row - dy * (CellGrid::Size - 1), col - dx * (CellGrid::Size - 1));
+                current.heat[index] = source->Current().heat[sourceIndex];
+                current.isBurning[index] = source->Current().isBurning[sourceIndex];
+            } else {
+                current.heat[index] = 0.0f;
+                current.isBurning[index] = false;
+            }
+        };
+        for (int col = -1; col <= CellGrid::Size; ++col) {
+            fill(-1, col);
+            fill(CellGrid::Size, col);
+        }
+        for (int row = 0; row < CellGrid::Size; ++row) {
+            fill(row, -1);
+            fill(row, CellGrid::Size);
+        }
+    }
+
+    // Vertex colors are stored per quadrant, seam vertices are written to every quadrant holding them
+    void SetVertexGray(VertexColors& colors, int row, int col, uint8_t value) {
+        CellGrid::QuadrantVertex copies[4];
+        int count = CellGrid::QuadrantCopies(row, col, copies);
+        for (int i = 0; i < count; ++i) {
+            auto& color = colors[copies[i].quadrant][copies[i].vertex];
+            color[0] = value;  // R
+            color[1] = value;  // G
+            color[2] = value;  // B
+        }
+    }
+
+    // Lowers the staged color of the vertex to the given gray, rounded to a color step
+    void DarkenVertexTo(FireCellState& state, int row, int col, uint8_t value) {
+        value = FireCellState::QuantizeGray(value);
+        auto [quadrant, vertex] = CellGrid::ToQuadrant(row, col);
+        const auto& color = state.stagedColors[quadrant][vertex];
+        if (color[0] > value || color[1] > value || color[2] > value) {
+            SetVertexGray(state.stagedColors, row, col, value);
+            state.stagedVertices.Set(row, col);
+        }
+    }
+}
+
+void FireSimulation::PeriodicUpdate(float delta, const WeatherSnapshot& weather,
+                                    std::vector<AlteredCell>& alteredCells) {
+    std::vector<Ignition> ignitions;
+    {
+        std::unique_lock fires_lock(fireCellMapMutex);
+        RestorePendingCellsLocked(RestoresPerTick);
+
+        // Impacts queued since the last tick land first, merged per vertex, the tick then spreads their heat
+        impacts.Drain([this](const ImpactRecord& impact) { CollectImpact(impact.pos, impact.radius, impact.damage); });
+        ApplyPendingHeat(ignitions);
+
+        BurnParams params{};
+        params.spreadScale = delta / settings.HeatDistributionFactor;
+        params.fuelBurn = settings.FuelConsumptionRate * delta;
+        params.heatGain = settings.FuelConsumptionRate * settings.FuelToHeatRate * delta;
+        params.selfHeatLoss = settings.SelfHeatLoss * delta;
+
+        // Spread only depends on the weather, every vertex of the tick shares the same weights
+        for (int d = 0; d < 8; ++d) {
+            params.spreadWeights[d] = weather.spreadWeights[d] * params.spreadScale;
+        }
+
+        // Cells with active vertices take part, plus the sleeping neighbours their fire reaches.
+        // Fixed cell order keeps the result independent of hash map layout and task timing
+        std::vector<CellCoord> tickCells;
+        for (const auto& [cell, handle] : fireCellMap) {
+            if (!statePool.Get(handle)->active.Empty()) {
+                tickCells.push_back(cell);
+            }
+        }
+        const size_t awakeCount = tickCells.size();
+        for (size_t i = 0; i < awakeCount; ++i) {
+            const auto* entry = cells.Find(tickCells[i]);
+            if (!entry) {
+                continue;  // Detached, it only burns again once reattached
+            }
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    const auto* neighbour = entry->neighbours[(dy + 1) * 3 + dx + 1];
+                    if (!neighbour || neighbour == entry || !BurnsTowards(*entry->state, dx, dy)) continue;
+                    if (neighbour->state && !neighbour->state->active.Empty()) continue;  // Awake already
+                    if (!GetOrCreateFireCellStateLocked(neighbour->coord)) continue;  // Land without colors
+                    tickCells.push_back(neighbour->coord);
+                }
+            }
+        }
+        std::sort(tickCells.begin(), tickCells.end(), CellLess);
+        tickCells.erase(std::unique(tickCells.begin(), tickCells.end()), tickCells.end());
+
+        // Resolve the surroundings of every cell once, the stencil itself never leaves the cell grid
+        std::vector<CellTick> ticks;
+        ticks.reserve(tickCells.size());
+        for (const auto& cell : tickCells) {
+            const auto* entry = cells.Find(cell);
+            auto* colors = entry ? land.GetVertexColors(cell) : nullptr;
+            if (!colors) {
+                continue;  // Land got unloaded
+            }
+            CellTick& tick = ticks.emplace_back(CellTick{cell, entry->state, colors, {}, {}, {}});
+            for (int slot = 0; slot < 9; ++slot) {
+                const auto* neighbour = entry->neighbours[slot];
+                tick.around[slot] = neighbour ? neighbour->state : nullptr;
+                tick.landAround[slot] = neighbour != nullptr;
+            }
+        }
+
+        // Every cell refreshes its ghost ring and burns its own vertices, reading only current buffers
+        pool.ParallelFor(ticks.size(), [this, &ticks, &params](size_t i) {
+            FillGhostRing(*ticks[i].state, ticks[i].around, ticks[i].landAround);
+            UpdateCell(ticks[i], params);
+        });
+
+        // Publish the tick
+        for (auto& work : ticks) {
+            work.state->Flip();
+            CommitColors(*work.state, *work.colors, false);
+            ReportColorChanges(work.cell, *work.state, false, alteredCells);
+            ignitions.insert(ignitions.end(), work.ignitions.begin(), work.ignitions.end());
+        }
+        for (const auto& cell : restoredCells) {
+            alteredCells.push_back(AlteredCell{cell, UINT16_MAX, CellGrid::Size * CellGrid::Size});
+        }
+        restoredCells.clear();
+        ignitions.insert(ignitions.end(), restoredIgnitions.begin(), restoredIgnitions.end());
+        restoredIgnitions.clear();
+        // Cells damaged outside of the tick may still be sleeping with pending color changes.
+        // Cells that stayed settled long enough go to cold storage, their colors are final by now
+        int imagesEncoded = 0;
+        for (auto it = fireCellMap.begin(); it != fireCellMap.end();) {
+            const auto& [cell, handle] = *it;
+            auto* state = statePool.Get(handle);
+            if (!state->active.Empty()) {
+                state->idleTicks = 0;
+                ++it;
+                continue;
+            }
+            auto* entry = cells.Find(cell);
+            auto* colors = entry ? land.GetVertexColors(cell) : nullptr;
+            if (colors && !state->stagedVertices.Empty()) {
+                CommitColors(*state, *colors, true);
+            }
+            ReportColorChanges(cell, *state, true, alteredCells);
+            if (state->dirty && imagesEncoded < ImagesPerTick) {
+                auto& image = liveImages[cell];
+                image.clear();
+                CellImage::Encode(*state, &state->stagedColors, image);
+                state->dirty = false;
+                ++imagesEncoded;
+            }
+            if (++state->idleTicks < EvictAfterIdleTicks) {
+                ++it;
+                continue;
+            }
+            auto image = liveImages.extract(cell);
+            if (!image.empty() && !state->dirty) {
+                // Already encoded, the land shows its colors as long as the cell stays attached
+                bool colorsShown = colors && (CellImage::GetSections(image.mapped()) & CellImage::HasColors);
+                coldCells.Insert(cell, std::move(image.mapped()), colorsShown);
+            } else {
+                coldCells.Store(cell, *state, colors != nullptr);  // Committed in full above
+            }
+            if (entry) {
+                entry->state = nullptr;
+            }
+            statePool.Release(handle);
+            it = fireCellMap.erase(it);
+        }
+        coldCells.Trim(static_cast<size_t>(settings.ColdStorageBudgetMB * 1024.0f * 1024.0f));
+    }
+
+    ReportIgnitions(ignitions);
+}
+
+void FireSimulation::UpdateCell(CellTick& work, const BurnParams& params) {
+    const auto& set = settings;
+    auto& fireCell = *work.state;
+    const auto& current = fireCell.Current();
+    auto& next = fireCell.Next();
+    next = current;
+
+    // Besides the active vertices, everything next to a burning vertex receives heat this tick.
+    // Burning masks include the ghost ring: bit col + 1 of entry row + 1 is vertex (row, col)
+    uint64_t burning[CellGrid::Rows] = {};
+    auto markBurning = [&](int row, int col) {
+        if (current.isBurning[CellGrid::Index(row, col)]) {
+            burning[row + 1] |= uint64_t{1} << (col + 1);
+        }
+    };
+    fireCell.active.ForEach(markBurning);  // Burning vertices are always active
+    for (int col = -1; col <= CellGrid::Size; ++col) {
+        markBurning(-1, col);
+        markBurning(CellGrid::Size, col);
+    }
+    for (int row = 0; row < CellGrid::Size; ++row) {
+        markBurning(row, -1);
+        markBurning(row, CellGrid::Size);
+    }
+    VertexSet update = fireCell.active;
+    constexpr uint64_t rowMask = (uint64_t{1} << CellGrid::Size) - 1;
+    for (int row = 0; row < CellGrid::Size; ++row) {
+        uint64_t near = burning[row] | burning[row + 1] | burning[row + 2];
+        update.rows[row] |= ((near | near << 1 | near >> 1) >> 1) & rowMask;
+    }
+
+    // Heat, fuel and flags of the whole cell, row by row
+    alignas(CellGrid::Alignment) float incoming[CellGrid::Cells];
+    alignas(CellGrid::Alignment) int32_t hits[CellGrid::Cells];
+    for (int row = 0; row < CellGrid::Size; ++row) {
+        if (update.rows[row]) {
+            kernel.run(fireCell, next, row, update.rows[row], params, incoming, hits);
+        }
+    }
+
+    // Colors, ignitions and the pulled heat
+    VertexSet stillActive;
+    update.ForEach([&](int row, int col) {
+        const int i = CellGrid::Index(row, col);
+        if (current.isBurning[i]) {
+            if (next.isCharred[i]) {
+                // Burnt out this tick
+                DarkenVertexTo(fireCell, row, col, 0);
+            } else {
+                // Update color based on fuel left
+                float fuelRatio = next.fuel[i] / set.DefaultInitialFuelAmount;
+                uint8_t colorValue = static_cast<uint8_t>(128.0f - (128.0f * (1.0f - fuelRatio)));
+                DarkenVertexTo(fireCell, row, col, colorValue);
+            }
+        }
+
+        if (hits[i] > 0 && ApplyDamage(fireCell, next, true, row, col, incoming[i], true, hits[i])) {
+            work.ignitions.push_back(
+                Ignition{CellGrid::ToFireVertex(work.cell, row, col), next.fuel[i] / set.FuelConsumptionRate});
+        }
+
+        if (next.isBurning[i] || next.heat[i] > 0) {
+            stillActive.Set(row, col);
+        }
+    });
+    fireCell.active = stillActive;
+}
+
+void FireSimulation::AddFireEvent(const WorldPoint& impactPos, float radius, float damage) {
+    std::vector<Ignition> ignitions;
+    {
+        std::unique_lock lock(fireCellMapMutex);
+        CollectImpact(impactPos, radius, damage);
+        ApplyPendingHeat(ignitions);
+    }
+    ReportIgnitions(ignitions);
+}
+
+bool FireSimulation::QueueImpact(const ImpactRecord& impact) { return impacts.Push(impact); }
+
+void FireSimulation::CollectImpact(const WorldPoint& impactPos, float radius, float damage) {
+    if (radius > 128.0f) {  // This Will affect more than one vertex
+        CollectDisc(impactPos, radius, damage);
+        return;
+    }
+    auto NearestVertex = FindNearestVertex(impactPos);
+    if (!NearestVertex || GetVertexPosition2D(*NearestVertex).GetDistance2D(impactPos) > 128.0f) {
+        return;
+    }
+    FireCellState* cellState = GetOrCreateFireCellStateLocked(NearestVertex->cell);
+    if (!cellState) {
+        return;  // Land got unloaded
+    }
+    int row = CellGrid::Row(NearestVertex->quadrant, NearestVertex->vertex);
+    int col = CellGrid::Col(NearestVertex->quadrant, NearestVertex->vertex);
+    AddPendingHeat(cellState, true, NearestVertex->cell, row, col, damage);
+}
+
+void FireSimulation::AddPendingHeat(FireCellState* state, bool hasLand, const CellCoord& cell, int row, int col,
+                                    float amount) {
+    auto [it, inserted] = pendingIndex.try_emplace(PendingKey{state, CellGrid::Index(row, col)}, pendingHeat.size());
+    if (inserted) {
+        pendingHeat.push_back(PendingHeat{state, cell, row, col, amount, 1, hasLand});
+    } else {
+        auto& pending = pendingHeat[it->second];
+        pending.amount += amount;
+        ++pending.hits;
+    }
+}
+
+void FireSimulation::ApplyPendingHeat(std::vector<Ignition>& ignitions) {
+    for (const auto& pending : pendingHeat) {
+        auto& current = pending.state->Current();
+        if (pending.amount < 0) {
+            ApplyCooling(*pending.state, current, pending.row, pending.col, -pending.amount);
+        } else if (ApplyDamage(*pending.state, current, pending.hasLand, pending.row, pending.col, pending.amount,
+                               false, pending.hits)) {
+            float HazardLifetime = current.fuel[CellGrid::Index(pending.row, pending.col)] /
+                                   settings.FuelConsumptionRate;
+            ignitions.push_back(Ignition{CellGrid::ToFireVertex(pending.cell, pending.row, pending.col),
+                                         HazardLifetime});
+        }
+    }
+    pendingHeat.clear();
+    pendingIndex.clear();
+}
+
+void FireSimulation::CommitColors(FireCellState& state, VertexColors& colors, bool settled) {
+    VertexSet waiting;
+    state.stagedVertices.ForEach([&](int row, int col) {
+        auto [quadrant, vertex] = CellGrid::ToQuadrant(row, col);
+        const auto& staged = state.stagedColors[quadrant][vertex];
+        const auto& shown = colors[quadrant][vertex];
+        int difference = 0;
+        for (int channel = 0; channel < 3; ++channel) {
+            difference = std::max(difference, std::abs(staged[channel] - shown[channel]));
+        }
+        if (difference == 0) {
+            return;
+        }
+        if (difference < FireCellState::ColorStep && !settled) {
+            waiting.Set(row, col);
+            return;
+        }
+        CellGrid::QuadrantVertex copies[4];
+        int count = CellGrid::QuadrantCopies(row, col, copies);
+        for (int i = 0; i < count; ++i) {
+            std::memcpy(colors[copies[i].quadrant][copies[i].vertex],
+                        state.stagedColors[copies[i].quadrant][copies[i].vertex], sizeof(colors[0][0]));
+        }
+        state.MarkColorChange(row, col);
+    });
+    state.stagedVertices = waiting;
+}
+
+void FireSimulation::ReportColorChanges(const CellCoord& cell, FireCellState& state, bool settled,
+                                        std::vector<AlteredCell>& alteredCells) {
+    // A creeping front changes a few vertices per tick, they are reported together. Settled colors are final.
+    const int changes = state.GetColorChanges();
+    if (changes == 0 || (!settled && changes < settings.MinReportedColorChanges)) {
+        return;
+    }
+    alteredCells.push_back(AlteredCell{cell, state.GetDirtyTiles(), changes});
+    state.ClearColorChanges();
+}
+
+void FireSimulation::ReportIgnitions(const std::vector<Ignition>& ignitions) {
+    if (OnVertexIgnited) {
+        for (const auto& ignition : ignitions) {
+            OnVertexIgnited(ignition.vertex, ignition.lifetime);
+        }
+    }
+}
+
+bool FireSimulation::ApplyDamage(FireCellState& cellState, FireCellState::Buffer& buffer, bool hasLand, int row,
+                                 int col, float damage, bool mgr, int hits) {
+    if (damage <= 0.0f) {
+        return false;  // No damage to apply
+    }
+    if (!hasLand) {
+        return false;  // Land got unloaded
+    }
+    const int index = CellGrid::Index(row, col);
+    cellState.active.Set(row, col);
+    cellState.dirty = true;
+
+    if (buffer.fuel[index] <= 0.0f || !cellState.canBurn.Test(row, col) || buffer.isCharred[index]) {
+        // vertex adjusted to vertex with grass sometimes have grass
+        if (mgr) {
+            CellGrid::QuadrantVertex copies[4];
+            int count = CellGrid::QuadrantCopies(row, col, copies);
+            for (int hit = 0; hit < hits; ++hit) {
+                for (int c = 0; c < count; ++c) {
+                    auto& colors = cellState.stagedColors[copies[c].quadrant][copies[c].vertex];
+                    if (colors[0] > 15 || colors[1] > 15 || colors[2] > 15) {
+                        colors[0] -= 15;  // R
+                        colors[1] -= 15;  // G
+                        colors[2] -= 15;  // B
+                    } else if (colors[0] != 0 || colors[1] != 0 || colors[2] != 0) {
+                        colors[0] = 0;  // R
+                        colors[1] = 0;  // G
+                        colors[2] = 0;  // B
+                    }
+                }
+            }
+            cellState.stagedVertices.Set(row, col);
+        }
+        return false;
+    }  // If no fuel, can't burn, or already charred, do nothing
+
+    buffer.heat[index] += damage;
+
+    if (!buffer.isBurning[index]) {  // If not already burning, check if it should start burning
+
+        if (buffer.heat[index] / cellState.minBurnHeat[index] >= 1.0f) {
+            buffer.isBurning[index] = true;
+            return true;
+
+        } else {
+            float heatRatio = buffer.heat[index] / cellState.minBurnHeat[index];
+            uint8_t colorValue = static_cast<uint8_t>(128.0f + (128.0f * (1.0f - heatRatio)));
+            DarkenVertexTo(cellState, row, col, colorValue);
+        }
+    }
+    return false;
+}
+
+void FireSimulation::ApplyCooling(FireCellState& cellState, FireCellState::Buffer& buffer, int row, int col,
+                                  float amount) {
+    int index = CellGrid::Index(row, col);
+
+    if (buffer.fuel[index] <= 0 || !cellState.canBurn.Test(row, col) || buffer.isCharred[index]) {
+        return;
+    }  // If no fuel, can't burn, or already charred, do nothing
+
+    if (buffer.heat[index] > 0) {
+        cellState.active.Set(row, col);
+        cellState.dirty = true;
+        buffer.heat[index] -= amount;
+        if (buffer.isBurning[index] && buffer.heat[index] <= 0) {
+            buffer.heat[index] = 0;
+            buffer.isBurning[index] = false;
+        }
+    }
+}
+
+void FireSimulation::CollectDisc(const WorldPoint& center, float radius, float damage) {
+    auto origin = land.GetCellAt(center.x, center.y);
+    if (!origin) {
+        return;
+    }
+    constexpr int CellSteps = CellGrid::Size - 1;  // Vertex steps per cell, the last vertex starts the next cell
+
+    // Vertices covered by the bounding box of the disc, in world vertex coordinates
+    const int firstX = static_cast<int>(std::ceil((center.x - radius) / VertexSpacing));
+    const int lastX = static_cast<int>(std::floor((center.x + radius) / VertexSpacing));
+    const int firstY = static_cast<int>(std::ceil((center.y - radius) / VertexSpacing));
+    const int lastY = static_cast<int>(std::floor((center.y + radius) / VertexSpacing));
+    // Every cell storing one of them, cell c stores vertices c * CellSteps to (c + 1) * CellSteps
+    auto firstCell = [](int first) { return static_cast<int>(std::ceil((first - CellSteps) / float(CellSteps))); };
+    auto lastCell = [](int last) { return static_cast<int>(std::floor(last / float(CellSteps))); };
+
+    for (int cellY = firstCell(firstY); cellY <= lastCell(lastY); ++cellY) {
+        for (int cellX = firstCell(firstX); cellX <= lastCell(lastX); ++cellX) {
+            const CellCoord cell{origin->worldSpace, cellX, cellY};
+            auto* colors = cells.Find(cell) ? land.GetVertexColors(cell) : nullptr;
+            if (!colors) continue;
+            FireCellState* state = nullptr;  // Created on the first vertex inside the disc
+
+            const int rowBegin = std::max(firstY - cellY * CellSteps, 0);
+            const int rowEnd = std::min(lastY - cellY * CellSteps, CellSteps);
+            for (int row = rowBegin; row <= rowEnd; ++row) {
+                // Columns inside the disc on this row
+                const float worldY = static_cast<float>(cellY * CellSteps + row) * VertexSpacing;
+                const float dy = worldY - center.y;
+                const float span = radius * radius - dy * dy;
+                if (span <= 0.0f) continue;
+                const float halfWidth = std::sqrt(span);
+                const int colBegin = std::max(
+                    static_cast<int>(std::ceil((center.x - halfWidth) / VertexSpacing)) - cellX * CellSteps, 0);
+                const int colEnd = std::min(
+                    static_cast<int>(std::floor((center.x + halfWidth) / VertexSpacing)) - cellX * CellSteps,
+                    CellSteps);
+
+                for (int col = colBegin; col <= colEnd; ++col) {
+                    const float worldX = static_cast<float>(cellX * CellSteps + col) * VertexSpacing;
+                    float distance = center.GetDistance2D(WorldPoint{worldX, worldY, 0.0f});
+                    if (distance >= radius) continue;
+                    if (!state) {
+                        state = GetOrCreateFireCellStateLocked(cell);
+                    }
+                    float adjustedDamage = damage * (1.0f - (distance / radius));  // Scale damage by distance
+                    AddPendingHeat(state, true, cell, row, col, adjustedDamage);
+                }
+            }
+        }
+    }
+}
+
+WorldPoint FireSimulation::GetVertexPosition2D(const FireVertex& vertex) {
+    // Cell world origin
+    float cellWorldX = vertex.cell.x * CellWorldSize;
+    float cellWorldY = vertex.cell.y * CellWorldSize;
+
+    // Quadrant (qx, qy)
+    int qx = vertex.quadrant % 2;
+    int qy = vertex.quadrant / 2;
+
+    // Vertex (vx, vy) in quadrant
+    int vx = vertex.vertex % VertsPerQuadRow;
+    int vy = vertex.vertex / VertsPerQuadRow;
+
+    float vertWorldX = cellWorldX + qx * QuadrantWorldSize + vx * VertexSpacing;
+    float vertWorldY = cellWorldY + qy * QuadrantWorldSize + vy * VertexSpacing;
+
+    return WorldPoint{vertWorldX, vertWorldY, 0.0f};
+}
+
+std::optional<float> FireSimulation::GetCachedHeight(float worldX, float worldY) {
+    auto cell = land.GetCellAt(worldX, worldY);
+    if (!cell) {
+        return std::nullopt;
+    }
+    return GetCachedHeight(cell->worldSpace, worldX, worldY);
+}
+
+std::optional<float> FireSimulation::GetCachedHeight(uint32_t worldSpace, float worldX, float worldY) {
+    const CellCoord cell{worldSpace, static_cast<int>(std::floor(worldX / CellWorldSize)),
+                         static_cast<int>(std::floor(worldY / CellWorldSize))};
+    std::shared_lock lock(fireCellMapMutex);
+    auto it = fireCellMap.find(cell);
+    if (it == fireCellMap.end()) {
+        return std::nullopt;
+    }
+    const auto& height = statePool.Get(it->second)->height;
+
+    // Bilinear between the 4 surrounding vertices, close enough to place effects on the terrain
+    float gridX = std::clamp((worldX - cell.x * CellWorldSize) / VertexSpacing, 0.0f, CellGrid::Size - 1.0f);
+    float gridY = std::clamp((worldY - cell.y * CellWorldSize) / VertexSpacing, 0.0f, CellGrid::Size - 1.0f);
+    int col = std::min(static_cast<int>(gridX), CellGrid::Size - 2);
+    int row = std::min(static_cast<int>(gridY), CellGrid::Size - 2);
+    float fx = gridX - col;
+    float fy = gridY - row;
+    float top = height[CellGrid::Index(row, col)] * (1.0f - fx) + height[CellGrid::Index(row, col + 1)] * fx;
+    float bottom =
+        height[CellGrid::Index(row + 1, col)] * (1.0f - fx) + height[CellGrid::Index(row + 1, col + 1)] * fx;
+    return top * (1.0f - fy) + bottom * fy;
+}
+
+std::optional<FireVertex> FireSimulation::FindNearestVertex(const WorldPoint& pos) {
+    auto cell = land.GetCellAt(pos.x, pos.y);
+    if (!cell || !cells.Find(*cell)) {
+        return std::nullopt;
+    }
+
+    // Local position within the cell (0 to 4096)
+    float localX = pos.x - (cell->x * CellWorldSize);
+    float localY = pos.y - (cell->y * CellWorldSize);
+
+    // Determine quadrant:
+    // Quadrants are split like:
+    //  0 | 1
+    // ---+---
+    //  2 | 3
+    // Determine quadrant
+    int quadrantX = (localX >= 2048) ? 1 : 0;
+    int quadrantY = (localY >= 2048) ? 1 : 0;
+    int quadrant = quadrantY * 2 + quadrantX;
+
+    // Convert to quadrant-local coordinates
+    float quadLocalX = localX - (quadrantX * 2048);
+    float quadLocalY = localY - (quadrantY * 2048);
+
+    // Vertex index in 17x17 grid
+    int vertX = std::clamp(static_cast<int>(std::round(quadLocalX / 128.0f)), 0, 16);
+    int vertY = std::clamp(static_cast<int>(std::round(quadLocalY / 128.0f)), 0, 16);
+    int vertIndex = vertY * 17 + vertX;
+
+    return FireVertex{*cell, quadrant, vertIndex};
+}
+
+WeatherSnapshot FireSimulation::CaptureWeather() {
+    WeatherSnapshot weather{};
+    weather.raining = land.IsCurrentWeatherRaining();
+    weather.rainFactor = weather.raining ? settings.RainingFactor : 1.0f;
+    weather.wind = land.GetCurrentWind();
+
+    const auto& wind = GetWindWeights(weather.wind);
+    weather.windDirX = wind.windDirX;
+    weather.windDirY = wind.windDirY;
+    for (int d = 0; d < 8; ++d) {
+        // Directions with no positive share spread nothing
+        weather.spreadWeights[d] = std::max(wind.weights[d] * weather.rainFactor, 0.0f);
+    }
+    return weather;
+}
+
+const FireSimulation::WindWeights& FireSimulation::GetWindWeights(WindData wind) {
+    if (windWeights && windWeights->wind.speed == wind.speed && windWeights->wind.direction == wind.direction &&
+        windWeights->windSpeedFactor == settings.WindSpeedFactor) {
+        return *windWeights;
+    }
+
+    // Unit direction vectors matching CellGrid::NeighbourOffsets:
+    // 0: NW, 1: N, 2: NE, 3: W, 4: E, 5: SW, 6: S, 7: SE
+    constexpr float Diagonal = 0.70710678f;
+    constexpr float dirX[8] = {-Diagonal, 0.0f, Diagonal, -1.0f, 1.0f, -Diagonal, 0.0f, Diagonal};
+    constexpr float dirY[8] = {-Diagonal, -1.0f, -Diagonal, 0.0f, 0.0f, Diagonal, 1.0f, Diagonal};
+
+    // Base weights: cardinal=1.0, diagonal=0.7
+    constexpr float baseWeights[8] = {0.7f, 1.0f, 0.7f, 1.0f, 1.0f, 0.7f, 1.0f, 0.7f};
+
+    // Wind direction vector (assumed radians)
+    constexpr float PI = 3.14159265358979323846f;
+    float angle = (static_cast<float>(wind.direction) / 256.0f) * 2.0f * PI;
+
+    WindWeights& table = windWeights.emplace();
+    table.wind = wind;
+    table.windSpeedFactor = settings.WindSpeedFactor;
+    table.windDirX = std::cos(angle);
+    table.windDirY = std::sin(angle);
+
+    float windSpeedNorm = static_cast<float>(wind.speed) / 255.0f;  // normalized 0..~1
+    for (int d = 0; d < 8; ++d) {
+        float dot = table.windDirX * dirX[d] + table.windDirY * dirY[d];
+        float windBoost = dot * windSpeedNorm * settings.WindSpeedFactor;  // alignment * speed * factor
+        table.weights[d] = baseWeights[d] * (1.0f + windBoost);
+    }
+    return table;
+}
+
+FireCellState* FireSimulation::GetOrCreateFireCellStateLocked(const CellCoord& cell) {
+    auto it = fireCellMap.find(cell);
+    if (it != fireCellMap.end()) {
+        return statePool.Get(it->second);
+    }
+    auto* colors = land.GetVertexColors(cell);
+    if (!colors) {
+        // Its original colors would read as black, a packed record stays packed until the land is back
+        return nullptr;
+    }
+    CellStateHandle handle = statePool.Acquire(land, cell, settings, fuelTable, pool);
+    fireCellMap.emplace(cell, handle);
+    FireCellState* state = statePool.Get(handle);
+    if (coldCells.Restore(cell, *state, colors)) {
+        // Hazards of vertices that were burning when the cell was packed
+        state->active.ForEach([&](int row, int col) {
+            const int index = CellGrid::Index(row, col);
+            if (state->Current().isBurning[index]) {
+                restoredIgnitions.push_back(Ignition{CellGrid::ToFireVertex(cell, row, col),
+                                                     state->Current().fuel[index] / settings.FuelConsumptionRate});
+            }
+        });
+    }
+    if (auto* entry = cells.Find(cell)) {
+        entry->state = state;
+    }
+    return state;
+}
+
+void FireSimulation::AttachCell(const CellCoord& cell, CellHandle handle) {
+    std::unique_lock lock(fireCellMapMutex);
+    auto& entry = cells.Attach(cell, handle);
+    auto it = fireCellMap.find(cell);
+    entry.state = it != fireCellMap.end() ? statePool.Get(it->second) : nullptr;
+    if (entry.state) {
+        // Land comes back with its original colors, the next commit darkens it again
+        for (auto& bits : entry.state->stagedVertices.rows) {
+            bits = (uint64_t{1} << CellGrid::Size) - 1;
+        }
+    } else if (coldCells.Contains(cell)) {
+        pendingRestores.push_back(cell);
+    }
+}
+
+void FireSimulation::ReviveColdCell(const CellCoord& cell) {
+    if (coldCells.HasFire(cell)) {
+        GetOrCreateFireCellStateLocked(cell);
+    } else if (coldCells.ApplyColors(cell, land.GetVertexColors(cell))) {
+        restoredCells.push_back(cell);
+    }
+}
+
+void FireSimulation::DetachCell(const CellCoord& cell) {
+    std::unique_lock lock(fireCellMapMutex);
+    cells.Detach(cell);
+    coldCells.ForgetColors(cell);
+}
+
+std::unordered_map<CellCoord, CompactFireCell> FireSimulation::GetFireCellMap() {
+    std::shared_lock lock(fireCellMapMutex);
+    std::unordered_map<CellCoord, CompactFireCell> snapshot;
+    snapshot.reserve(fireCellMap.size());
+    for (const auto& [cell, handle] : fireCellMap) {
+        snapshot.emplace(cell, CompactFireCell(*statePool.Get(handle)));
+    }
+    return snapshot;
+}
+
+size_t FireSimulation::GetColdCellCount() {
+    std::shared_lock lock(fireCellMapMutex);
+    return coldCells.GetCount();
+}
+
+size_t FireSimulation::GetColdStorageBytes() {
+    std::shared_lock lock(fireCellMapMutex);
+    return coldCells.GetBytes();
+}
+
+void FireSimulation::CollectCellImages(
+    const std::function<void(const CellCoord&, std::span<const uint8_t>)>& write) {
+    std::unique_lock lock(fireCellMapMutex);
+
+    struct Encoding {
+        const FireCellState* state;
+        std::vector<uint8_t>* image;
+    };
+    std::vector<Encoding> encodings;
+    for (const auto& [cell, handle] : fireCellMap) {
+        auto* state = statePool.Get(handle);
+        auto& image = liveImages[cell];
+        if (state->dirty || image.empty()) {
+            state->dirty = false;
+            image.clear();
+            encodings.push_back({state, &image});
+        }
+    }
+    // Staged colors are complete even for detached cells, the land is never read
+    pool.ParallelFor(encodings.size(), [&encodings](size_t i) {
+        CellImage::Encode(*encodings[i].state, &encodings[i].state->stagedColors, *encodings[i].image);
+    });
+
+    for (const auto& [cell, image] : liveImages) {
+        write(cell, image);
+    }
+    coldCells.ForEach(write);
+}
+
+size_t FireSimulation::LoadCellImages(std::vector<SavedCell> saved) {
+    std::vector<uint8_t> valid(saved.size());  // Not vector<bool>, workers write neighbouring entries
+    pool.ParallelFor(saved.size(), [&saved, &valid](size_t i) { valid[i] = CellImage::Validate(saved[i].image); });
+
+    std::unique_lock lock(fireCellMapMutex);
+    size_t loaded = 0;
+    for (size_t i = 0; i < saved.size(); ++i) {
+        if (!valid[i]) {
+            continue;
+        }
+        coldCells.Insert(saved[i].cell, std::move(saved[i].image), false);
+        if (cells.Find(saved[i].cell)) {
+            pendingRestores.push_back(saved[i].cell);  // Attached before the load
+        }
+        ++loaded;
+    }
+    return loaded;
+}
+
+size_t FireSimulation::RestorePendingCells(size_t maxCells) {
+    std::unique_lock lock(fireCellMapMutex);
+    return RestorePendingCellsLocked(maxCells);
+}
+
+size_t FireSimulation::RestorePendingCellsLocked(size_t maxCells) {
+    for (size_t restored = 0; restored < maxCells && !pendingRestores.empty();) {
+        CellCoord cell = pendingRestores.front();
+        pendingRestores.pop_front();
+        // Detached, reset or hit by fire again since it was queued
+        if (cells.Find(cell) && !fireCellMap.contains(cell) && coldCells.Contains(cell)) {
+            ReviveColdCell(cell);
+            ++restored;
+        }
+    }
+    return pendingRestores.size();
+}
+
+void FireSimulation::ResetFireCellState(const CellCoord& cell) {
+    std::unique_lock lock(fireCellMapMutex);
+    ResetFireCellStateLocked(cell);
+    // Nothing restored from the cell is reported any more
+    std::erase(restoredCells, cell);
+    std::erase_if(restoredIgnitions, [&cell](const Ignition& ignition) { return ignition.vertex.cell == cell; });
+    std::erase(pendingRestores, cell);
+}
+
+void FireSimulation::ResetFireCellStateLocked(const CellCoord& cell) {
+    auto* colors = land.GetVertexColors(cell);
+    if (auto it = fireCellMap.find(cell); it != fireCellMap.end()) {
+        if (colors) {
+            auto& OrgColors = statePool.Get(it->second)->originalColors;
+            std::memcpy(*colors, OrgColors, sizeof(OrgColors));
+        }
+        statePool.Release(it->second);
+        fireCellMap.erase(it);
+    }
+    // Packed cells are dropped without rebuilding them, their land only loses the darkening it shows
+    coldCells.Drop(cell, colors);
+    if (auto* entry = cells.Find(cell)) {
+        entry->state = nullptr;
+    }
+    liveImages.erase(cell);
+}
+
+void FireSimulation::ResetAllFireCells() {
+    std::unique_lock lock(fireCellMapMutex);
+    std::vector<CellCoord> cellsToReset;
+    for (const auto& [cell, handle] : fireCellMap) {
+        cellsToReset.push_back(cell);
+    }
+    const auto coldCellList = coldCells.GetCells();
+    cellsToReset.insert(cellsToReset.end(), coldCellList.begin(), coldCellList.end());
+    for (const auto& cell : cellsToReset) {
+        ResetFireCellStateLocked(cell);
+    }
+    restoredCells.clear();
+    restoredIgnitions.clear();
+    pendingRestores.clear();
+    // Impacts from before the reset, e.g. the session a load replaces, must not burn the new world. The tick drains
+    // under this lock too, so this is still the only consumer.
+    impacts.Drain([](const ImpactRecord&) {});
+    pendingHeat.clear();
+    pendingIndex.clear();
+}
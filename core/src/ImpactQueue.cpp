@@ -0,0 +1,27 @@
+#include "WildfireCore/ImpactQueue.h"
+
+ImpactQueue::ImpactQueue() : slots(std::make_unique<Slot[]>(Capacity)) {
+    for (size_t i = 0; i < Capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ImpactQueue::Push(const ImpactRecord& record) {
+    size_t position = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[position & (Capacity - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == position) {
+            // Free for this lap, claim it
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (sequence < position) {
+            return false;  // Still holds the record from the previous lap, the queue is full
+        } else {
+            position = tail.load(std::memory_order_relaxed);  // Another producer got it first
+        }
+    }
+}
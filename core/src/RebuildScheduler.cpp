@@ -0,0 +1,63 @@
+#include "WildfireCore/RebuildScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Weight a request gains per second of waiting, cells far away or behind the camera get their turn eventually
+    constexpr float AgingPerSecond = 1.0f;
+    // Share of the priority cells behind the camera keep
+    constexpr float BehindFactor = 0.25f;
+}
+
+void RebuildScheduler::Request(const CellCoord& cell, float weight, uint16_t tiles) {
+    auto [it, inserted] = requests.try_emplace(cell, Pending{weight, tiles, Clock::now()});
+    if (!inserted) {
+        it->second.weight += weight;
+        it->second.tiles |= tiles;
+    }
+}
+
+std::optional<CellCoord> RebuildScheduler::Pop(const View& view, Clock::time_point now) {
+    // Only loaded cells get requests, a scan over a few dozen beats keeping a heap ordered for a moving camera
+    auto best = requests.end();
+    float bestPriority = -1.0f;
+    for (auto it = requests.begin(); it != requests.end(); ++it) {
+        float waitSeconds = std::chrono::duration<float>(now - it->second.since).count();
+        float priority =
+            GetPriority(it->first, it->second.tiles, it->second.weight, std::max(waitSeconds, 0.0f), view);
+        if (priority > bestPriority) {
+            best = it;
+            bestPriority = priority;
+        }
+    }
+    if (best == requests.end()) {
+        return std::nullopt;
+    }
+    CellCoord cell = best->first;
+    requests.erase(best);
+    return cell;
+}
+
+float RebuildScheduler::GetPriority(const CellCoord& cell, uint16_t tiles, float weight, float waitSeconds,
+                                    const View& view) {
+    constexpr float TileWorldSize = CellGrid::TileSize * VertexSpacing;
+    float best = 0.0f;
+    for (int tile = 0; tile < CellGrid::Tiles; ++tile) {
+        if (!(tiles & (1u << tile))) continue;
+        const float tileX = cell.x * CellWorldSize + (tile % CellGrid::TilesPerRow + 0.5f) * TileWorldSize;
+        const float tileY = cell.y * CellWorldSize + (tile / CellGrid::TilesPerRow + 0.5f) * TileWorldSize;
+        const float toX = tileX - view.camera.x;
+        const float toY = tileY - view.camera.y;
+        const float distance = std::sqrt(toX * toX + toY * toY) / CellWorldSize;  // In cells
+
+        // Tiles around the camera are always in view, farther ones by the angle to the view direction
+        float facing = 1.0f;
+        if (distance > 0.5f) {
+            float cosAngle = (toX * view.forwardX + toY * view.forwardY) / (distance * CellWorldSize);
+            facing = BehindFactor + (1.0f - BehindFactor) * std::max(cosAngle, 0.0f);
+        }
+        best = std::max(best, facing / (1.0f + distance * distance));
+    }
+    return (weight + waitSeconds * AgingPerSecond) * best;
+}
@@ -0,0 +1,114 @@
+#include "WildfireCore/SyntheticLand.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // Cheap integer hash, good enough to scatter textures deterministically
+    uint32_t Hash(uint32_t seed, int x, int y) {
+        uint32_t h = seed * 0x9E3779B1u;
+        h ^= static_cast<uint32_t>(x) * 0x85EBCA77u;
+        h = (h << 13) | (h >> 19);
+        h ^= static_cast<uint32_t>(y) * 0xC2B2AE3Du;
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        return h;
+    }
+}
+
+SyntheticLand::SyntheticLand(int cellsPerSide, uint32_t seed, float grassCoverage)
+    : cellsPerSide(cellsPerSide), minCell(-(cellsPerSide / 2)) {
+    for (int cy = minCell; cy < minCell + cellsPerSide; ++cy) {
+        for (int cx = minCell; cx < minCell + cellsPerSide; ++cx) {
+            auto cell = std::make_unique<Cell>();
+            std::memset(cell->layers.percents, 0, sizeof(cell->layers.percents));
+
+            for (int q = 0; q < 4; ++q) {
+                cell->layers.defQuadTextures[q] = kDirt;
+                cell->layers.quadTextures[q][0] = kGrass;
+                cell->layers.quadTextures[q][1] = kDryGrass;
+                for (int t = 2; t < 6; ++t) {
+                    cell->layers.quadTextures[q][t] = kNone;
+                }
+
+                for (int v = 0; v < VertsPerQuad; ++v) {
+                    // World-space vertex index so seams between quadrants and cells stay consistent
+                    int wx = cx * 32 + (q % 2) * 16 + v % VertsPerQuadRow;
+                    int wy = cy * 32 + (q / 2) * 16 + v / VertsPerQuadRow;
+                    uint32_t h = Hash(seed, wx, wy);
+
+                    float roll = static_cast<float>(h & 0xFFFF) / 65535.0f;
+                    if (roll < grassCoverage) {
+                        float dry = static_cast<float>((h >> 16) & 0xFF) / 255.0f;
+                        cell->layers.percents[q][v][0] = 1.0f - dry;
+                        cell->layers.percents[q][v][1] = dry;
+                    }
+
+                    uint8_t shade = static_cast<uint8_t>(160 + ((h >> 24) & 0x3F));
+                    cell->colors[q][v][0] = shade;
+                    cell->colors[q][v][1] = shade;
+                    cell->colors[q][v][2] = shade;
+                }
+            }
+            cells.emplace(CellCoord{WorldSpace, cx, cy}, std::move(cell));
+        }
+    }
+}
+
+std::optional<CellCoord> SyntheticLand::GetCellAt(float worldX, float worldY) {
+    CellCoord coord{WorldSpace, static_cast<int>(std::floor(worldX / CellWorldSize)),
+                    static_cast<int>(std::floor(worldY / CellWorldSize))};
+    if (!HasLand(coord)) {
+        return std::nullopt;
+    }
+    return coord;
+}
+
+bool SyntheticLand::HasLand(const CellCoord& cell) { return cells.contains(cell); }
+
+VertexColors* SyntheticLand::GetVertexColors(const CellCoord& cell) {
+    auto it = cells.find(cell);
+    return it != cells.end() ? &it->second->colors : nullptr;
+}
+
+bool SyntheticLand::GetTextureLayers(const CellCoord& cell, LandTextureLayers& out) {
+    auto it = cells.find(cell);
+    if (it == cells.end()) {
+        return false;
+    }
+    std::memcpy(&out, &it->second->layers, sizeof(out));
+    return true;
+}
+
+bool SyntheticLand::GetVertexHeights(const CellCoord& cell, VertexHeights& out) {
+    if (!cells.contains(cell)) {
+        return false;
+    }
+    for (int q = 0; q < 4; ++q) {
+        for (int v = 0; v < VertsPerQuad; ++v) {
+            float x = cell.x * CellWorldSize + (q % 2) * QuadrantWorldSize + (v % VertsPerQuadRow) * VertexSpacing;
+            float y = cell.y * CellWorldSize + (q / 2) * QuadrantWorldSize + (v / VertsPerQuadRow) * VertexSpacing;
+            out[q][v] = GetLandHeight(x, y);
+        }
+    }
+    return true;
+}
+
+float SyntheticLand::GetLandHeight(float worldX, float worldY) {
+    // Gentle rolling hills
+    return 256.0f * std::sin(worldX / 8192.0f) * std::cos(worldY / 8192.0f);
+}
+
+void SyntheticLand::GetTextureGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out) {
+    switch (texture) {
+        case kGrass:
+            out.push_back(GrassFireConfig{"grass", true, 50, 25});
+            break;
+        case kDryGrass:
+            out.push_back(GrassFireConfig{"drygrass", true, 40, 15});
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,21 @@
+#include "WildfireCore/TextureFuelTable.h"
+
+#include <mutex>
+
+void TextureFuelTable::GetGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out) {
+    {
+        std::shared_lock lock(mutex);
+        if (auto it = configs.find(texture); it != configs.end()) {
+            out.insert(out.end(), it->second.begin(), it->second.end());
+            return;
+        }
+    }
+
+    // Resolved outside the lock, a texture resolved twice by racing threads gives the same configs
+    std::vector<GrassFireConfig> resolved;
+    land.GetTextureGrassConfigs(texture, resolved);
+    out.insert(out.end(), resolved.begin(), resolved.end());
+
+    std::unique_lock lock(mutex);
+    configs.try_emplace(texture, std::move(resolved));
+}
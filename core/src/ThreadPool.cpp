@@ -0,0 +1,136 @@
+#include "WildfireCore/ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+    // Pool and queue index of the current thread, so tasks submitted by a worker stay local
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local size_t currentQueue = 0;
+
+    // Empty polls a waiting ParallelFor makes before it sleeps until the chunks still running elsewhere finish
+    constexpr int SpinsBeforeWaiting = 64;
+}
+
+ThreadPool::ThreadPool(unsigned workerCount) {
+    workerCount = std::max(workerCount, 1u);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned ThreadPool::WorkersFor(unsigned reservedThreads) {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > reservedThreads + 1 ? hardware - reservedThreads : 1;
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    size_t index = currentPool == this ? currentQueue
+                                       : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::unique_lock lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::unique_lock lock(sleepMutex);
+        queued.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1) {
+        body(0);
+        return;
+    }
+
+    struct Batch {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+    } batch;
+    batch.remaining.store(count, std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        Submit([&body, &batch, i]() {
+            body(i);
+            if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::unique_lock lock(batch.mutex);
+                batch.done.notify_one();
+            }
+        });
+    }
+
+    // Help out while there is work to take. Once the queues are empty every remaining chunk is already running, so
+    // after a short spin the caller sleeps instead of burning its core until the slowest one finishes.
+    const size_t preferred = currentPool == this ? currentQueue : 0;
+    for (int spins = 0; batch.remaining.load(std::memory_order_acquire) > 0;) {
+        if (TryRunTask(preferred)) {
+            spins = 0;
+        } else if (++spins < SpinsBeforeWaiting) {
+            std::this_thread::yield();
+        } else {
+            std::unique_lock lock(batch.mutex);
+            batch.done.wait(lock, [&batch]() { return batch.remaining.load(std::memory_order_acquire) == 0; });
+        }
+    }
+}
+
+bool ThreadPool::TryRunTask(size_t preferred) {
+    std::function<void()> task;
+    {
+        // Own queue from the back, newest tasks are the ones still warm in cache
+        auto& own = *queues[preferred];
+        std::unique_lock lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (size_t offset = 1; !task && offset < queues.size(); ++offset) {
+        // Steal from the front of the others
+        auto& other = *queues[(preferred + offset) % queues.size()];
+        std::unique_lock lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void ThreadPool::WorkerLoop(size_t index) {
+    currentPool = this;
+    currentQueue = index;
+    while (true) {
+        if (TryRunTask(index)) {
+            continue;
+        }
+        std::unique_lock lock(sleepMutex);
+        wake.wait(lock, [this]() { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
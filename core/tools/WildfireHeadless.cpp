@@ -0,0 +1,151 @@
+// Runs the fire simulation on synthetic terrain and reports tick timings.
+// Usage: WildfireHeadless [cellsPerSide=7] [ticks=120] [windSpeed=0] [windDirection=0] [seed=1] [Setting=value...]
+// Settings use the SimSettings field names, e.g. FuelToHeatRate=8 HeatDistributionFactor=4
+
+#include "WildfireCore/FireSimulation.h"
+#include "WildfireCore/SyntheticLand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct FireStats {
+        int burning = 0;
+        int charred = 0;
+        int heated = 0;
+    };
+
+    FireStats CountVertices(FireSimulation& sim) {
+        FireStats stats;
+        for (const auto& [cell, state] : sim.GetFireCellMap()) {
+            for (int row = 0; row < CellGrid::Size; ++row) {
+                for (int col = 0; col < CellGrid::Size; ++col) {
+                    stats.burning += state.IsBurning(row, col);
+                    stats.charred += state.IsCharred(row, col);
+                    stats.heated += state.Heat(row, col) > 0.0f;
+                }
+            }
+        }
+        return stats;
+    }
+
+    int ArgOr(int argc, char** argv, int index, int fallback) {
+        return argc > index && !std::strchr(argv[index], '=') ? std::atoi(argv[index]) : fallback;
+    }
+
+    bool ApplySettingOverride(SimSettings& settings, std::string_view arg) {
+        static const std::pair<std::string_view, float SimSettings::*> fields[] = {
+            {"DefaultMinHeatToBurn", &SimSettings::DefaultMinHeatToBurn},
+            {"DefaultInitialFuelAmount", &SimSettings::DefaultInitialFuelAmount},
+            {"HeatDistributionFactor", &SimSettings::HeatDistributionFactor},
+            {"FuelConsumptionRate", &SimSettings::FuelConsumptionRate},
+            {"FuelToHeatRate", &SimSettings::FuelToHeatRate},
+            {"SelfHeatLoss", &SimSettings::SelfHeatLoss},
+            {"RainingFactor", &SimSettings::RainingFactor},
+            {"WindSpeedFactor", &SimSettings::WindSpeedFactor},
+            {"ColdStorageBudgetMB", &SimSettings::ColdStorageBudgetMB},
+            {"MinReportedColorChanges", &SimSettings::MinReportedColorChanges},
+        };
+        auto split = arg.find('=');
+        if (split == std::string_view::npos) {
+            return false;
+        }
+        for (const auto& [name, field] : fields) {
+            if (arg.substr(0, split) == name) {
+                settings.*field = std::strtof(arg.data() + split + 1, nullptr);
+                return true;
+            }
+        }
+        std::fprintf(stderr, "Unknown setting '%.*s'\n", static_cast<int>(split), arg.data());
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    const int cellsPerSide = ArgOr(argc, argv, 1, 7);
+    const int ticks = ArgOr(argc, argv, 2, 120);
+
+    SyntheticLand land(cellsPerSide, static_cast<uint32_t>(ArgOr(argc, argv, 5, 1)));
+    land.wind = WindData{static_cast<uint8_t>(ArgOr(argc, argv, 3, 0)), static_cast<uint8_t>(ArgOr(argc, argv, 4, 0))};
+
+    SimSettings settings;
+    for (int i = 1; i < argc; ++i) {
+        ApplySettingOverride(settings, argv[i]);
+    }
+    ThreadPool pool(ThreadPool::WorkersFor(1));
+    CellRegistry registry;
+    FireSimulation sim(land, settings, pool, registry);
+
+    // Every synthetic cell is loaded, SyntheticLand resolves them by coordinate so there is no handle
+    auto AttachAll = [&land](FireSimulation& target) {
+        for (int y = land.GetMinCell(); y < land.GetMinCell() + land.GetCellsPerSide(); ++y) {
+            for (int x = land.GetMinCell(); x < land.GetMinCell() + land.GetCellsPerSide(); ++x) {
+                target.AttachCell(CellCoord{SyntheticLand::WorldSpace, x, y}, 0);
+            }
+        }
+    };
+    AttachAll(sim);
+
+    int ignitions = 0;
+    sim.OnVertexIgnited = [&ignitions](const FireVertex&, float) { ++ignitions; };
+
+    // A fireball in the middle of the map, landing with the first tick
+    sim.QueueImpact(ImpactRecord{WorldPoint{2048.0f, 2048.0f, 0.0f}, 512.0f, 200.0f});
+
+    std::vector<AlteredCell> alteredCells;
+    size_t alteredReports = 0;
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    for (int tick = 0; tick < ticks; ++tick) {
+        alteredCells.clear();
+        auto start = std::chrono::high_resolution_clock::now();
+        sim.PeriodicUpdate(1.0f, sim.CaptureWeather(), alteredCells);
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+        alteredReports += alteredCells.size();
+    }
+
+    auto stats = CountVertices(sim);
+    std::printf("cells %d x %d, ticks %d, %s kernel, %u workers\n", cellsPerSide, cellsPerSide, ticks,
+                sim.GetKernelName(), pool.GetWorkerCount());
+    std::printf("tick avg %.3f ms, worst %.3f ms\n", ticks ? totalMs / ticks : 0.0, worstMs);
+    std::printf("ignitions %d, burning %d, charred %d, heated %d, tracked cells %zu\n", ignitions, stats.burning,
+                stats.charred, stats.heated, sim.GetFireCellMap().size());
+    std::printf("cold cells %zu, %zu bytes, altered cell reports %zu\n", sim.GetColdCellCount(),
+                sim.GetColdStorageBytes(), alteredReports);
+
+    // Save round trip: images of every changed cell, read back by a fresh simulation over the same land
+    std::vector<FireSimulation::SavedCell> images;
+    size_t imageBytes = 0;
+    auto saveStart = std::chrono::high_resolution_clock::now();
+    sim.CollectCellImages([&](const CellCoord& cell, std::span<const uint8_t> image) {
+        images.push_back({cell, std::vector<uint8_t>(image.begin(), image.end())});
+        imageBytes += image.size();
+    });
+    auto saveEnd = std::chrono::high_resolution_clock::now();
+
+    CellRegistry loadedRegistry;
+    FireSimulation loaded(land, settings, pool, loadedRegistry);
+    const size_t savedCount = images.size();
+    // Like a game load: records first, then the cells attach and get restored a few per tick
+    loaded.LoadCellImages(std::move(images));
+    AttachAll(loaded);
+    int restoreTicks = 0;
+    while (loaded.RestorePendingCells(4) > 0) {
+        ++restoreTicks;
+    }
+    auto reloaded = CountVertices(loaded);
+    std::printf("saved %zu cells, %zu bytes in %.3f ms, reloaded burning %d, charred %d, heated %d in %d ticks\n",
+                savedCount, imageBytes, std::chrono::duration<double, std::milli>(saveEnd - saveStart).count(),
+                reloaded.burning, reloaded.charred, reloaded.heated, restoreTicks + 1);
+    return 0;
+}
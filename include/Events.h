@@ -1,6 +1,18 @@
 #pragma once
 
+#include "ClibUtil/singleton.hpp"
+
 namespace Events {
 
+    // Registers exterior cells with the fire simulation once they are fully loaded.
+    // Detached cells are dropped by WildfireMgr at the start of each tick.
+    class CellLoadHandler : public clib_util::singleton::ISingleton<CellLoadHandler>,
+                            public RE::BSTEventSink<RE::TESCellFullyLoadedEvent> {
+    public:
+        static void Register();
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::TESCellFullyLoadedEvent* event,
+                                              RE::BSTEventSource<RE::TESCellFullyLoadedEvent>*) override;
+    };
 
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 
 #include "ClibUtil/singleton.hpp"
 
+#include <optional>
 #include <shared_mutex>
 
 class HazardMgr : public clib_util::singleton::ISingleton<HazardMgr> {
@@ -22,6 +23,17 @@ public:
     void SpawnHazardAt(RE::NiPoint3 pos, RE::BGSHazard* hazardForm, float lifetime);
 
 private:
+    struct HazardPlacement {
+        RE::NiPoint3 pos;
+        float angle;
+        float scale;
+        bool onGround;  // pos.z holds the terrain height
+    };
+
+    // Randomized placement, the height comes from the heights cached for worldSpace when the simulation tracks the
+    // cell. Reads no game state, safe off the main thread.
+    HazardPlacement PrepareHazardAt(RE::NiPoint3 pos, std::optional<std::uint32_t> worldSpace);
+    void PlaceHazard(const HazardPlacement& placement, RE::BGSHazard* hazardForm, float lifetime);
 
     std::shared_mutex burnGridMutex;
     std::unordered_map<HazardGridCoord, float> burnGrid;
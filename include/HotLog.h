@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Logging for code that runs per impact or per frame.
+// Every call site lets one message through per HotLog::Interval and counts the rest, so a fire fight can't flood the
+// log. Levels below WILDFIRE_HOT_LOG_LEVEL are removed by the preprocessor, arguments included.
+
+#ifndef WILDFIRE_HOT_LOG_LEVEL
+    #ifdef NDEBUG
+        #define WILDFIRE_HOT_LOG_LEVEL SPDLOG_LEVEL_INFO
+    #else
+        #define WILDFIRE_HOT_LOG_LEVEL SPDLOG_LEVEL_TRACE
+    #endif
+#endif
+
+namespace HotLog {
+    using Clock = std::chrono::steady_clock;
+
+    inline constexpr auto Interval = std::chrono::seconds(1);
+
+    // Rate limit of one call site
+    class RateLimit {
+    public:
+        // Number of messages dropped since the last one that passed, or -1 when this one is dropped
+        int64_t Pass() {
+            const auto now = Clock::now().time_since_epoch().count();
+            auto next = nextAllowed.load(std::memory_order_relaxed);
+            if (now < next ||
+                !nextAllowed.compare_exchange_strong(next, now + IntervalTicks, std::memory_order_relaxed)) {
+                suppressed.fetch_add(1, std::memory_order_relaxed);
+                return -1;
+            }
+            return suppressed.exchange(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr Clock::rep IntervalTicks = std::chrono::duration_cast<Clock::duration>(Interval).count();
+
+        std::atomic<Clock::rep> nextAllowed = 0;
+        std::atomic<int64_t> suppressed = 0;
+    };
+}
+
+#define WILDFIRE_HOT_LOG(severity, func, ...)                                                      \
+    do {                                                                                           \
+        if (spdlog::should_log(spdlog::level::severity)) {                                         \
+            static HotLog::RateLimit hotLogLimit;                                                  \
+            if (auto suppressed = hotLogLimit.Pass(); suppressed >= 0) {                           \
+                if (suppressed > 0) {                                                              \
+                    logger::func("{} similar messages suppressed", suppressed);                    \
+                }                                                                                  \
+                logger::func(__VA_ARGS__);                                                         \
+            }                                                                                      \
+        }                                                                                          \
+    } while (false)
+
+#if WILDFIRE_HOT_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+    #define HOT_LOG_TRACE(...) WILDFIRE_HOT_LOG(trace, trace, __VA_ARGS__)
+#else
+    #define HOT_LOG_TRACE(...) (void)0
+#endif
+
+#if WILDFIRE_HOT_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+    #define HOT_LOG_DEBUG(...) WILDFIRE_HOT_LOG(debug, debug, __VA_ARGS__)
+#else
+    #define HOT_LOG_DEBUG(...) (void)0
+#endif
+
+#if WILDFIRE_HOT_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+    #define HOT_LOG_INFO(...) WILDFIRE_HOT_LOG(info, info, __VA_ARGS__)
+#else
+    #define HOT_LOG_INFO(...) (void)0
+#endif
+
+#define HOT_LOG_WARN(...) WILDFIRE_HOT_LOG(warn, warn, __VA_ARGS__)
+#define HOT_LOG_ERROR(...) WILDFIRE_HOT_LOG(err, error, __VA_ARGS__)
@@ -1,6 +1,7 @@
 #pragma once
 #include "RE/Skyrim.h"
 #include "SKSE/SKSE.h"
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <wrl/client.h>
 
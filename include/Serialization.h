@@ -1 +1,16 @@
+#pragma once
 
+// Fire state in the SKSE co-save.
+// One record per cell the fire changed, holding its coordinates and a CellImage, see WildfireCore/CellImage.h.
+namespace Serialization {
+    inline constexpr std::uint32_t UniqueID = 'WDFR';
+    inline constexpr std::uint32_t CellRecord = 'CELL';
+    inline constexpr std::uint32_t Version = 1;
+
+    // Registers the callbacks, call once after SKSE::Init
+    void Install();
+
+    void SaveCallback(SKSE::SerializationInterface* serde);
+    void LoadCallback(SKSE::SerializationInterface* serde);
+    void RevertCallback(SKSE::SerializationInterface* serde);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "WildfireCore/CellRegistry.h"
+#include "WildfireCore/LandProvider.h"
+
+// LandProvider backed by the loaded game world.
+// Cells are resolved through the registry of attached cells, their handles are RE::TESObjectCELL pointers.
+class SkyrimLand : public LandProvider {
+public:
+    explicit SkyrimLand(CellRegistry& cells) : cells(cells) {}
+
+    std::optional<CellCoord> GetCellAt(float worldX, float worldY) override;
+    bool HasLand(const CellCoord& cell) override;
+
+    VertexColors* GetVertexColors(const CellCoord& cell) override;
+    bool GetTextureLayers(const CellCoord& cell, LandTextureLayers& out) override;
+    bool GetVertexHeights(const CellCoord& cell, VertexHeights& out) override;
+    float GetLandHeight(float worldX, float worldY) override;
+
+    void GetTextureGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out) override;
+
+    WindData GetCurrentWind() override;
+    bool IsCurrentWeatherRaining() override;
+
+    // Conversions between engine cells and simulation coordinates, GetCell only finds attached cells
+    RE::TESObjectCELL* GetCell(const CellCoord& cell);
+    static std::optional<CellCoord> GetCellCoord(RE::TESObjectCELL* cell);
+
+private:
+    RE::TESObjectLAND::LoadedLandData* GetLoadedData(const CellCoord& cell);
+
+    CellRegistry& cells;
+};
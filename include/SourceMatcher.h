@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Types.h"
+
+#include <string>
+#include <vector>
+
+// Fire / cold / water source patterns compiled into one Aho-Corasick automaton.
+// A text is walked once, lowercased on the fly, every pattern ending at a position is found by a single lookup.
+class SourceMatcher {
+public:
+    // Patterns are expected in lowercase, like Settings stores them
+    void Compile(const std::vector<std::string>& fire, const std::vector<std::string>& cold,
+                 const std::vector<std::string>& water);
+
+    // Category of the first matching list, checked in fire, cold, water order. Unknown for null or no match.
+    ProjectileType Match(const char* text) const;
+
+    size_t GetStateCount() const { return output.size(); }
+
+private:
+    int classCount = 1;           // Class 0 is every byte that appears in no pattern
+    uint16_t charClass[256] = {};  // Byte -> class, upper and lower case share one
+    std::vector<int32_t> next;     // Complete transition table, state * classCount + class
+    std::vector<uint8_t> output;   // Categories of every pattern ending in a state, bit 1 << ProjectileType
+};
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "SkyrimLand.h"
 #include "Types.h"
+#include "WildfireCore/FireSimulation.h"
+#include "WildfireCore/RebuildScheduler.h"
+#include "WildfireCore/ThreadPool.h"
 
 #include "ClibUtil/singleton.hpp"
 
-#include <future>
 #include <shared_mutex>
 
 
@@ -21,48 +24,61 @@ inline bool ContainsKeywordInsensitive(const RE::BSFixedString& modelPath, const
 
 class WildfireMgr : public clib_util::singleton::ISingleton<WildfireMgr> {
 public:
+    WildfireMgr();
+
     void PeriodicUpdate(float delta);
+    // Rebuilds the grass of altered cells, most visible first, within Settings::GrassRebuildBudgetMs
     void GenerateGrassInQueueCells();
 
     void AddFireEvent(const RE::NiPoint3& impactPos, float radius, float damage);
-    bool IsCellAltered(RE::TESObjectCELL* cell);
-    void DamageFireCell(FireVertex target, float damage, bool mgr = false);
-    void CoolFireCell(FireVertex target, float damage);
+    // Constant cost, for engine callbacks. Applied by the next PeriodicUpdate.
+    void QueueImpact(const RE::NiPoint3& impactPos, float radius, float damage);
 
-    std::unordered_map<RE::TESObjectCELL*, FireCellState> GetFireCellMap() const { return fireCellMap; };
+    std::unordered_map<CellCoord, CompactFireCell> GetFireCellMap() { return simulation.GetFireCellMap(); };
 
     
+    // Terrain height from the vertex heights cached by the simulation, raycasts only outside tracked cells.
+    // Main thread only.
+    float GetLandHeight(float worldX, float worldY);
+    // Cached heights only, no game access, so workers may call it with a worldspace read on the main thread
+    std::optional<float> GetCachedLandHeight(uint32_t worldSpace, float worldX, float worldY) {
+        return simulation.GetCachedHeight(worldSpace, worldX, worldY);
+    }
+
     // Wind-related methods
     WindData GetCurrentWind();
     bool IsCurrentWeatherRaining();
 
+    // Co-save access, see FireSimulation::CollectCellImages and LoadCellImage
+    void CollectCellImages(const std::function<void(const CellCoord&, std::span<const uint8_t>)>& write) {
+        simulation.CollectCellImages(write);
+    }
+    size_t LoadCellImages(std::vector<FireSimulation::SavedCell> saved) {
+        return simulation.LoadCellImages(std::move(saved));
+    }
+
     void ResetFireCellState(RE::TESObjectCELL* cell);
     void ResetAllFireCells();
 
-private:
+    // Registers a loaded exterior cell with land, called from the cell load events
+    void AttachCell(RE::TESObjectCELL* cell);
 
-    // Get or create a FireCellState for the given cell
-    FireCellState* GetOrCreateFireCellState(RE::TESObjectCELL* cell);
+    // Workers shared by the fire tick, grass evaluation and hazard preparation
+    ThreadPool& GetThreadPool() { return pool; }
 
-    // Vertex-related methods
-    FireVertex FindNearestVertex(const RE::NiPoint3& pos);
-    std::vector<FireVertex> FindNearestVertexsInRadius(const RE::NiPoint3& pos, const float radius);
+private:
 
-    // Get neighbours of a vertex
-    std::vector<FireVertex> GetFireVertexNeighbours(const FireVertex& vertex);
-    std::vector<WeightedNeighbour> GetFireVertexNeighboursWeighted(const FireVertex& vertex, WindData windData);
-    
-    // Cell-related methods
-    std::pair<int, int> GetCellCoords(RE::TESObjectCELL* cell);
-    RE::TESObjectCELL* GetCellByCoords(int cellX, int cellY);
+    // Forgets registered cells the game detached since the last tick
+    void DetachUnloadedCells();
 
-    
-    std::shared_mutex fireCellMapMutex;
-    std::unordered_map<RE::TESObjectCELL*, FireCellState> fireCellMap;
+    ThreadPool pool;
+    CellRegistry cells;
+    SkyrimLand land;
+    FireSimulation simulation;
 
-    std::shared_mutex cellTasksMutex;
-    std::unordered_map<RE::TESObjectCELL*, std::future<void>> cellTasks;
+    std::atomic<uint32_t> droppedImpacts = 0;  // Impacts rejected by a full queue since the last tick
 
     std::shared_mutex grassGenerationMutex;
-    std::queue<RE::TESObjectCELL*> grassGenerationQueue;
+    RebuildScheduler grassRebuilds;
+    float grassRebuildMs = 1.0f;  // Running average cost of one cell, grass tasks included
 };
\ No newline at end of file
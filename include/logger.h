@@ -6,14 +6,19 @@ static void SetupLog() {
     auto pluginName = SKSE::PluginDeclaration::GetSingleton()->GetName();
     auto logFilePath = *logsFolder / std::format("{}.log", pluginName);
     auto fileLoggerPtr = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logFilePath.string(), true);
-    auto loggerPtr = std::make_shared<spdlog::logger>("log", std::move(fileLoggerPtr));
+    // Messages are formatted and written by a background thread. When the queue is full the oldest message is
+    // dropped, the game thread never waits for the file.
+    spdlog::init_thread_pool(8192, 1);
+    auto loggerPtr = std::make_shared<spdlog::async_logger>("log", std::move(fileLoggerPtr), spdlog::thread_pool(),
+                                                            spdlog::async_overflow_policy::overrun_oldest);
     spdlog::set_default_logger(std::move(loggerPtr));
 #ifndef NDEBUG
     spdlog::set_level(spdlog::level::trace);
     spdlog::flush_on(spdlog::level::trace);
 #else
     spdlog::set_level(spdlog::level::info);
-    spdlog::flush_on(spdlog::level::info);
+    spdlog::flush_on(spdlog::level::warn);
+    spdlog::flush_every(std::chrono::seconds(3));
 #endif
     logger::info("Name of the plugin is {}.", pluginName);
     logger::info("Version of the plugin is {}.", SKSE::PluginDeclaration::GetSingleton()->GetVersion());
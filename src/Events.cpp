@@ -1,5 +1,20 @@
 #include "Events.h"
+#include "WildfireMgr.h"
 
 namespace Events {
-    
-}
\ No newline at end of file
+
+    void CellLoadHandler::Register() {
+        if (auto* holder = RE::ScriptEventSourceHolder::GetSingleton()) {
+            holder->AddEventSink<RE::TESCellFullyLoadedEvent>(GetSingleton());
+        }
+    }
+
+    RE::BSEventNotifyControl CellLoadHandler::ProcessEvent(const RE::TESCellFullyLoadedEvent* event,
+                                                           RE::BSTEventSource<RE::TESCellFullyLoadedEvent>*) {
+        if (event && event->cell) {
+            WildfireMgr::GetSingleton()->AttachCell(event->cell);
+        }
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+}
@@ -2,6 +2,7 @@
 #include "WildfireMgr.h"
 #include "Settings.h"
 #include "Utils.h"
+#include "HotLog.h"
 
 #include <random>
 
@@ -33,6 +34,7 @@ void HazardMgr::PeriodicUpdate(float delta) {
     }
     */
 
+    std::vector<RE::NiPoint3> spawnPoints;
     for (auto it = burnGrid.begin(); it != burnGrid.end();) {
         it->second -= delta;
         if (it->second <= 0.0f) {
@@ -42,17 +44,36 @@ void HazardMgr::PeriodicUpdate(float delta) {
             pos.x = it->first.x;
             pos.y = it->first.y;
             pos.z = 0.0f;  // Z is calculated based on the terrain height
-            SpawnHazardAt(pos, FireDragonHazard, set->HazardPeriodicUpdateTime);
+            spawnPoints.push_back(pos);
             ++it;
         }
     }
+    lock.unlock();
+
+    // Offsets and cached terrain heights are prepared on the workers. The worldspace is read here, and the few
+    // points outside tracked cells get their raycast back on the main thread.
+    auto* wildfireMgr = WildfireMgr::GetSingleton();
+    std::optional<std::uint32_t> worldSpace;
+    if (auto* tes = RE::TES::GetSingleton(); tes && tes->worldSpace) {
+        worldSpace = tes->worldSpace->GetFormID();
+    }
+    std::vector<HazardPlacement> placements(spawnPoints.size());
+    wildfireMgr->GetThreadPool().ParallelFor(spawnPoints.size(), [&](size_t i) {
+        placements[i] = PrepareHazardAt(spawnPoints[i], worldSpace);
+    });
+    for (auto& placement : placements) {
+        if (!placement.onGround) {
+            placement.pos.z = wildfireMgr->GetLandHeight(placement.pos.x, placement.pos.y);
+        }
+        PlaceHazard(placement, FireDragonHazard, set->HazardPeriodicUpdateTime);
+    }
 }
 
 
 void HazardMgr::CreateBurningVertex(const FireVertex& vertex, float lifetime) {
     std::unique_lock lock(burnGridMutex);
-    auto coordinates = Utils::GetWorldPosition(vertex);
-    HazardGridCoord tempHazGirdCell{coordinates.x, coordinates.y};
+    auto coordinates = FireSimulation::GetVertexPosition2D(vertex);  // The grid only needs x / y
+    HazardGridCoord tempHazGirdCell{static_cast<int>(coordinates.x), static_cast<int>(coordinates.y)};
     burnGrid.emplace(tempHazGirdCell, lifetime);
 }
 
@@ -64,28 +85,41 @@ static float RandomFloat(float min, float max) {
 
 void HazardMgr::SpawnHazardAt(RE::NiPoint3 pos, RE::BGSHazard* hazardForm,
                                     float lifetime) {
-    if (!hazardForm) return;
+    auto placement = PrepareHazardAt(pos, std::nullopt);
+    placement.pos.z = WildfireMgr::GetSingleton()->GetLandHeight(placement.pos.x, placement.pos.y);
+    PlaceHazard(placement, hazardForm, lifetime);
+}
 
+HazardMgr::HazardPlacement HazardMgr::PrepareHazardAt(RE::NiPoint3 pos, std::optional<std::uint32_t> worldSpace) {
     pos.x += RandomFloat(-50.0f, 50.0f);  // Add some random offset to the position
     pos.y += RandomFloat(-50.0f, 50.0f);
-    float z = 0.0f;
-    RE::TES::GetSingleton()->GetLandHeight(pos, z);  // Get the terrain height at the position
-    pos.z = z;
+    std::optional<float> height;
+    if (worldSpace) {
+        height = WildfireMgr::GetSingleton()->GetCachedLandHeight(*worldSpace, pos.x, pos.y);
+    }
+    pos.z = height.value_or(0.0f);
+
+    return HazardPlacement{pos, RandomFloat(0.0f, 360.0f), RandomFloat(0.8f, 1.2f), height.has_value()};
+}
+
+void HazardMgr::PlaceHazard(const HazardPlacement& placement, RE::BGSHazard* hazardForm, float lifetime) {
+    if (!hazardForm) return;
 
+    const auto& pos = placement.pos;
     auto origlifetime = hazardForm->data.lifetime;
     hazardForm->data.lifetime = lifetime;
 
     auto player = RE::PlayerCharacter::GetSingleton();
     auto hazardRef = player->PlaceObjectAtMe(hazardForm, false);
     if (!hazardRef) {
-        logger::error("Failed to place hazard at vertex ({}, {}, {})", pos.x, pos.y, pos.z);
+        HOT_LOG_ERROR("Failed to place hazard at vertex ({}, {}, {})", pos.x, pos.y, pos.z);
         return;
     }
 
     hazardRef->SetPosition(pos);
-    hazardRef->data.angle = RE::NiPoint3{RandomFloat(0.0f, 360.0f), 0.0f, 0.0f};
+    hazardRef->data.angle = RE::NiPoint3{placement.angle, 0.0f, 0.0f};
 
-    float scale = RandomFloat(0.8f, 1.2f);
+    float scale = placement.scale;
     hazardForm->data.radius = scale;
     hazardRef->GetReferenceRuntimeData().refScale = static_cast<std::uint16_t>(scale * 100.0f);
 
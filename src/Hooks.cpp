@@ -4,6 +4,7 @@
 #include "Settings.h"
 #include "WildfireMgr.h"
 #include "HazardMgr.h"
+#include "HotLog.h"
 
 #include <chrono>
 #include <cmath>
@@ -16,50 +17,36 @@ namespace Hooks {
             return;  // If the mod is inactive, skip processing
         }
 
-        auto TES = RE::TES::GetSingleton();
-        auto cell = TES->GetCell(pos);
-        if (!cell) {
-            logger::warn("No cell found at position: ({}, {}, {})", pos.x, pos.y, pos.z);
-            return;  // If no cell found, skip processing
-        }
-        if (!cell->GetRuntimeData().cellLand) {
-            logger::warn("No cell land data found for cell at position: ({}, {}, {})", pos.x, pos.y, pos.z);
-            return;  // If no land data, skip processing
-        }
-
         float radius = 0.0f;
         if (a_proj->GetProjectileRuntimeData().explosion) {
             radius = a_proj->GetProjectileRuntimeData().explosion->data.radius;
             explosion_handled = true;
         }
 
-        auto* set = Settings::GetSingleton();
-        logger::info("Processing impact at position: ({}, {}, {})", pos.x, pos.y, pos.z);
-
-        auto start = std::chrono::high_resolution_clock::now();
-
+        // Classification is cached per source form, most impacts are not elemental and end here.
+        // Everything else only queues a record, cells and vertices are resolved by the next fire tick
         auto ProjectileType = Utils::GetProjectileType(a_proj);
+        if (ProjectileType == ProjectileType::Unknown) {
+            return;
+        }
+
+        auto* set = Settings::GetSingleton();
+        HOT_LOG_DEBUG("Queueing impact at position: ({}, {}, {})", pos.x, pos.y, pos.z);
 
         if (ProjectileType == ProjectileType::Fire) {
             float damage = Utils::GetDamageFromProjectile(a_proj) * set->FireDamageMultiplayer;
-            logger::info("Fire Damage {} radius: {}", damage, radius);
-            WildfireMgr::GetSingleton()->AddFireEvent(pos, radius, damage);
+            HOT_LOG_DEBUG("Fire Damage {} radius: {}", damage, radius);
+            WildfireMgr::GetSingleton()->QueueImpact(pos, radius, damage);
         } else if (ProjectileType == ProjectileType::Cold) {
             float damage = Utils::GetDamageFromProjectile(a_proj) * set->ColdDamageMultiplayer;
-            logger::info("Cold Damage {} radius: {}", damage, radius);
-            WildfireMgr::GetSingleton()->AddFireEvent(pos, radius, -damage);
+            HOT_LOG_DEBUG("Cold Damage {} radius: {}", damage, radius);
+            WildfireMgr::GetSingleton()->QueueImpact(pos, radius, -damage);
         } else if (ProjectileType == ProjectileType::Water) {
             float damage = Utils::GetDamageFromProjectile(a_proj) * set->WaterDamageMultiplayer;
-            logger::info("Water Damage {} radius: {}", damage, radius);
-            WildfireMgr::GetSingleton()->AddFireEvent(pos, radius, -damage);
-        } else {
-            logger::warn("Unknown projectile type: {}", a_proj->GetFormEditorID());
+            HOT_LOG_DEBUG("Water Damage {} radius: {}", damage, radius);
+            WildfireMgr::GetSingleton()->QueueImpact(pos, radius, -damage);
         }
 
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double, std::milli> duration = end - start;
-        logger::info("Processed in {} ms", duration.count());
-
         if (set->DebugMode) {
             DebugAPI_IMPL::DebugAPI::DrawSphere(glm::vec3(pos.x, pos.y, pos.z), 50, 5000,
                                                 glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), 2.0f);
@@ -71,28 +58,20 @@ namespace Hooks {
             return;  // If the mod is inactive, skip processing
         }
 
-        auto TES = RE::TES::GetSingleton();
-        auto cell = TES->GetCell(pos);
-        if (!cell) {
-            logger::warn("No cell found at position: ({}, {}, {})", pos.x, pos.y, pos.z);
-            return;  // If no cell found, skip processing
-        }
-        if (!cell->GetRuntimeData().cellLand) {
-            logger::warn("No cell land data found for cell at position: ({}, {}, {})", pos.x, pos.y, pos.z);
-            return;  // If no land data, skip processing
-        }
-
         if (explosion_handled) {
             explosion_handled = false;
             return;
         }
 
-        auto* set = Settings::GetSingleton();
-        logger::info("Processing Explosion at position: ({}, {}, {})", pos.x, pos.y, pos.z);
+        // Classification is cached per explosion base form
+        auto ProjectileType = Utils::GetExplosionType(exp);
+        if (ProjectileType == ProjectileType::Unknown) {
+            return;
+        }
 
-        auto start = std::chrono::high_resolution_clock::now();
+        auto* set = Settings::GetSingleton();
+        HOT_LOG_DEBUG("Queueing explosion at position: ({}, {}, {})", pos.x, pos.y, pos.z);
 
-        auto ProjectileType = Utils::GetExplosionType(exp);
         auto explosionRuntimeData = exp->GetExplosionRuntimeData();
 
         float damage = explosionRuntimeData.damage;
@@ -101,23 +80,19 @@ namespace Hooks {
         }
 
         if (ProjectileType == ProjectileType::Fire) {
-            logger::info("Fire Damage {} radius: {}", damage * set->FireDamageMultiplayer, explosionRuntimeData.radius);
-            WildfireMgr::GetSingleton()->AddFireEvent(pos, explosionRuntimeData.radius, damage);
+            HOT_LOG_DEBUG("Fire Damage {} radius: {}", damage * set->FireDamageMultiplayer,
+                          explosionRuntimeData.radius);
+            WildfireMgr::GetSingleton()->QueueImpact(pos, explosionRuntimeData.radius, damage);
         } else if (ProjectileType == ProjectileType::Cold) {
-            logger::info("Cold Damage {} radius: {}", damage * set->ColdDamageMultiplayer, explosionRuntimeData.radius);
-            WildfireMgr::GetSingleton()->AddFireEvent(pos, explosionRuntimeData.radius, -damage);
+            HOT_LOG_DEBUG("Cold Damage {} radius: {}", damage * set->ColdDamageMultiplayer,
+                          explosionRuntimeData.radius);
+            WildfireMgr::GetSingleton()->QueueImpact(pos, explosionRuntimeData.radius, -damage);
         } else if (ProjectileType == ProjectileType::Water) {
-            logger::info("Water Damage {} radius: {}", damage * set->WaterDamageMultiplayer,
-                         explosionRuntimeData.radius);
-            WildfireMgr::GetSingleton()->AddFireEvent(pos, explosionRuntimeData.radius, -damage);
-        } else {
-            logger::warn("Unknown exploson type: {}", exp->GetFormEditorID());
+            HOT_LOG_DEBUG("Water Damage {} radius: {}", damage * set->WaterDamageMultiplayer,
+                          explosionRuntimeData.radius);
+            WildfireMgr::GetSingleton()->QueueImpact(pos, explosionRuntimeData.radius, -damage);
         }
 
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double, std::milli> duration = end - start;
-        logger::info("Processed in {} ms", duration.count());
-
         if (set->DebugMode) {
             DebugAPI_IMPL::DebugAPI::DrawSphere(glm::vec3(pos.x, pos.y, pos.z), 50, 5000,
                                                 glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), 2.0f);
@@ -169,7 +144,7 @@ namespace Hooks {
                                      const RE::NiPoint3& a_velocity, RE::hkpCollidable* a_collidable,
                                      std::int32_t a_arg6, std::uint32_t a_arg7) {
         originalFunction(a_proj, a_ref, a_targetLoc, a_velocity, a_collidable, a_arg6, a_arg7);
-        logger::info("MissileImpact Hook");
+        HOT_LOG_TRACE("MissileImpact Hook");
         Hooks::ProcessImpact(a_proj, a_targetLoc);
     }
 
@@ -177,7 +152,7 @@ namespace Hooks {
                                   const RE::NiPoint3& a_velocity, RE::hkpCollidable* a_collidable, std::int32_t a_arg6,
                                   std::uint32_t a_arg7) {
         originalFunction(a_proj, a_ref, a_targetLoc, a_velocity, a_collidable, a_arg6, a_arg7);
-        logger::info("BeamImpact Hook");
+        HOT_LOG_TRACE("BeamImpact Hook");
         Hooks::ProcessImpact(a_proj, a_targetLoc);
     }
 
@@ -185,7 +160,7 @@ namespace Hooks {
                                    const RE::NiPoint3& a_velocity, RE::hkpCollidable* a_collidable, std::int32_t a_arg6,
                                    std::uint32_t a_arg7) {
         originalFunction(a_proj, a_ref, a_targetLoc, a_velocity, a_collidable, a_arg6, a_arg7);
-        logger::info("FlameImpact Hook");
+        HOT_LOG_TRACE("FlameImpact Hook");
         Hooks::ProcessImpact(a_proj, a_targetLoc);
     }
 
@@ -193,7 +168,7 @@ namespace Hooks {
                                      const RE::NiPoint3& a_velocity, RE::hkpCollidable* a_collidable,
                                      std::int32_t a_arg6, std::uint32_t a_arg7) {
         originalFunction(a_proj, a_ref, a_targetLoc, a_velocity, a_collidable, a_arg6, a_arg7);
-        logger::info("GrenadeImpact Hook");
+        HOT_LOG_TRACE("GrenadeImpact Hook");
         Hooks::ProcessImpact(a_proj, a_targetLoc);
     }
 
@@ -201,7 +176,7 @@ namespace Hooks {
                                   const RE::NiPoint3& a_velocity, RE::hkpCollidable* a_collidable, std::int32_t a_arg6,
                                   std::uint32_t a_arg7) {
         originalFunction(a_proj, a_ref, a_targetLoc, a_velocity, a_collidable, a_arg6, a_arg7);
-        logger::info("ConeImpact Hook");
+        HOT_LOG_TRACE("ConeImpact Hook");
         Hooks::ProcessImpact(a_proj, a_targetLoc);
     }
 
@@ -209,13 +184,13 @@ namespace Hooks {
                                    const RE::NiPoint3& a_velocity, RE::hkpCollidable* a_collidable, std::int32_t a_arg6,
                                    std::uint32_t a_arg7) {
         originalFunction(a_proj, a_ref, a_targetLoc, a_velocity, a_collidable, a_arg6, a_arg7);
-        logger::info("ArrowImpact Hook");
+        HOT_LOG_TRACE("ArrowImpact Hook");
         Hooks::ProcessImpact(a_proj, a_targetLoc);
     }
 
     void Hooks::ExplosionHook::thunk(RE::Explosion* a_this) {
         originalFunction(a_this);
-        logger::info("Explosion Hook");
+        HOT_LOG_TRACE("Explosion Hook");
         Hooks::ProcessExplosion(a_this, a_this->GetPosition());
     }
 
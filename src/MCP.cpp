@@ -37,7 +37,7 @@ namespace MCP {
         ImGui::SameLine();
         ImGui::Checkbox("Debug Mode", &set->DebugMode);
 
-        ImGui::SliderInt("Grass Generation Cells Per Frame Limit", &set->GrassGenerationCellsPerFrameLimit, 1, 10);
+        ImGui::SliderFloat("Grass Rebuild Budget (ms)", &set->GrassRebuildBudgetMs, 0.1f, 10.0f, "%.1f");
 
         ImGui::SliderFloat("Grass Periodic Update Time (s)", &set->GrassPeriodicUpdateTime, 0.1f, 10.0f, "%.1f");
         ImGui::SliderFloat("Hazard Periodic Update Time (s)", &set->HazardPeriodicUpdateTime, 0.1f, 10.0f, "%.1f");
@@ -50,6 +50,8 @@ namespace MCP {
         ImGui::SliderFloat("Water Damage Multiplayer", &set->WaterDamageMultiplayer, 0.1f, 10.0f, "%.1f");
         ImGui::SliderFloat("Raining Factor", &set->RainingFactor, 0.1f, 1.0f, "%.2f");
         ImGui::SliderFloat("Wind Speed Factor", &set->WindSpeedFactor, 0.1f, 10.0f, "%.1f");
+        ImGui::SliderFloat("Cold Storage Budget (MB)", &set->ColdStorageBudgetMB, 1.0f, 256.0f, "%.0f");
+        ImGui::SliderFloat("Min Color Changes For Grass", &set->MinReportedColorChanges, 1.0f, 256.0f, "%.0f");
     }
 
     static const char* GetCompassLabel(uint8_t windDir) {
@@ -97,7 +99,7 @@ namespace MCP {
     }
 
     void __stdcall RenderWildfireMgr() {
-        static std::unordered_map<RE::TESObjectCELL*, FireCellState> fireCellCache;
+        static std::unordered_map<CellCoord, CompactFireCell> fireCellCache;
         static bool FetchData = false;
         static auto WildfireMgr = WildfireMgr::GetSingleton();
         static auto player = RE::PlayerCharacter::GetSingleton();
@@ -132,7 +134,7 @@ namespace MCP {
 
         for (const auto& [cell, state] : fireCellCache) {
             ImGui::Separator();
-            std::string cellLabel = std::format("Cell: {:X}", cell->GetFormID());
+            std::string cellLabel = std::format("Cell: {}, {} ({:X})", cell.x, cell.y, cell.worldSpace);
             if (ImGui::CollapsingHeader(cellLabel.c_str())) {
                 ImGui::Columns(2, nullptr, false);  // 2 columns for quadrants
 
@@ -140,28 +142,30 @@ namespace MCP {
                 for (int q = 0; q <= 1; ++q) {
                     std::string quadLabel = std::format("Quadrant {}", q);
                     ImGui::Text("%s", quadLabel.c_str());
-                    if (ImGui::BeginTable(std::format("HeatTable{}_{}", (void*)cell, q).c_str(), 17,
+                    if (ImGui::BeginTable(std::format("HeatTable{}_{}_{}", cell.x, cell.y, q).c_str(), 17,
                                           ImGuiTableFlags_Borders)) {
                         // Table rows
                         for (int row = 0; row < 17; ++row) {
                             ImGui::TableNextRow();
                             for (int col = 0; col < 17; ++col) {
                                 ImGui::TableSetColumnIndex(col);
-                                int idx = row * 17 + col;
+                                int gridRow = CellGrid::Row(q, row * 17 + col);
+                                int gridCol = CellGrid::Col(q, row * 17 + col);
                                 ImVec4 color = ImVec4(0.75f, 0.75f, 0.75f, 1.0f);  // Gray by default
 
-                                if (state.isCharred[q][idx]) {
+                                if (state.IsCharred(gridRow, gridCol)) {
                                     color = ImVec4(0.0f, 0.0f, 0.0f, 1.0f);  // Black for charred
-                                } else if (state.isBurning[q][idx]) {
+                                } else if (state.IsBurning(gridRow, gridCol)) {
                                     color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);  // Red for burning
-                                } else if (state.heat[q][idx] != 0.0f) {
+                                } else if (state.Heat(gridRow, gridCol) != 0.0f) {
                                     color = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);  // Yellow for heated
-                                } else if (state.canBurn[q][idx]) {
+                                } else if (state.CanBurn(gridRow, gridCol)) {
                                     color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);  // Green for can burn
                                 }
                                 ImGui::PushStyleColor(ImGuiCol_Text, color);
-                                ImGui::Text("H%.0f", state.heat[q][idx] / state.minBurnHeat[q][idx]);
-                                ImGui::Text("F%.0f", state.fuel[q][idx]);
+                                ImGui::Text("H%.0f",
+                                            state.Heat(gridRow, gridCol) / state.MinBurnHeat(gridRow, gridCol));
+                                ImGui::Text("F%.0f", state.Fuel(gridRow, gridCol));
                                 ImGui::PopStyleColor();
                             }
                         }
@@ -174,27 +178,28 @@ namespace MCP {
                 for (int q = 2; q <= 3; ++q) {
                     std::string quadLabel = std::format("Quadrant {}", q);
                     ImGui::Text("%s", quadLabel.c_str());
-                    if (ImGui::BeginTable(std::format("HeatTable{}_{}", (void*)cell, q).c_str(), 17,
+                    if (ImGui::BeginTable(std::format("HeatTable{}_{}_{}", cell.x, cell.y, q).c_str(), 17,
                                           ImGuiTableFlags_Borders)) {
                         for (int row = 0; row < 17; ++row) {
                             ImGui::TableNextRow();
                             for (int col = 0; col < 17; ++col) {
                                 ImGui::TableSetColumnIndex(col);
-                                int idx = row * 17 + col;
+                                int gridRow = CellGrid::Row(q, row * 17 + col);
+                                int gridCol = CellGrid::Col(q, row * 17 + col);
                                 ImVec4 color = ImVec4(0.75f, 0.75f, 0.75f, 1.0f);  // Gray by default
 
-                                if (state.isCharred[q][idx]) {
+                                if (state.IsCharred(gridRow, gridCol)) {
                                     color = ImVec4(0.0f, 0.0f, 0.0f, 1.0f);  // Black for charred
-                                } else if (state.isBurning[q][idx]) {
+                                } else if (state.IsBurning(gridRow, gridCol)) {
                                     color = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);  // Red for burning
-                                } else if (state.heat[q][idx] != 0.0f) {
+                                } else if (state.Heat(gridRow, gridCol) != 0.0f) {
                                     color = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);  // Yellow for heated
-                                } else if (state.canBurn[q][idx]) {
+                                } else if (state.CanBurn(gridRow, gridCol)) {
                                     color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);  // Green for can burn
                                 }
                                 ImGui::PushStyleColor(ImGuiCol_Text, color);
-                                ImGui::Text("H%.0f", state.heat[q][idx]);
-                                ImGui::Text("F%.0f", state.fuel[q][idx]);
+                                ImGui::Text("H%.0f", state.Heat(gridRow, gridCol));
+                                ImGui::Text("F%.0f", state.Fuel(gridRow, gridCol));
 
                                 ImGui::PopStyleColor();
                             }
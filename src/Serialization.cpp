@@ -1 +1,83 @@
+#include "Serialization.h"
+#include "WildfireMgr.h"
 
+namespace {
+    // Fixed part of a cell record, the image bytes follow
+    struct CellHeader {
+        std::uint32_t worldSpace;
+        std::int32_t x, y;
+        std::uint32_t imageSize;
+    };
+}
+
+void Serialization::Install() {
+    auto* serde = SKSE::GetSerializationInterface();
+    serde->SetUniqueID(UniqueID);
+    serde->SetSaveCallback(SaveCallback);
+    serde->SetLoadCallback(LoadCallback);
+    serde->SetRevertCallback(RevertCallback);
+}
+
+void Serialization::SaveCallback(SKSE::SerializationInterface* serde) {
+    auto start = std::chrono::steady_clock::now();
+    size_t count = 0;
+    size_t bytes = 0;
+    bool failed = false;
+    WildfireMgr::GetSingleton()->CollectCellImages([&](const CellCoord& cell, std::span<const uint8_t> image) {
+        if (failed) {
+            return;
+        }
+        const CellHeader header{cell.worldSpace, cell.x, cell.y, static_cast<std::uint32_t>(image.size())};
+        if (!serde->OpenRecord(CellRecord, Version) || !serde->WriteRecordData(&header, sizeof(header)) ||
+            !serde->WriteRecordData(image.data(), static_cast<std::uint32_t>(image.size()))) {
+            logger::error("Failed to save the fire state of cell ({}, {})", cell.x, cell.y);
+            failed = true;
+            return;
+        }
+        ++count;
+        bytes += image.size();
+    });
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    logger::info("Saved the fire state of {} cells, {} bytes in {:.2f} ms", count, bytes, ms);
+}
+
+void Serialization::LoadCallback(SKSE::SerializationInterface* serde) {
+    // Records are only read here, decoding and restoring the cells happens later off the load path
+    std::vector<FireSimulation::SavedCell> saved;
+    std::uint32_t type, version, length;
+    while (serde->GetNextRecordInfo(type, version, length)) {
+        if (type != CellRecord) {
+            logger::warn("Unknown co-save record {:08X}, skipped", type);
+            continue;
+        }
+        if (version != Version) {
+            logger::warn("Cell record version {} is not supported, skipped", version);
+            continue;
+        }
+        CellHeader header;
+        if (length < sizeof(header) || serde->ReadRecordData(&header, sizeof(header)) != sizeof(header) ||
+            header.imageSize != length - sizeof(header)) {
+            logger::error("Malformed cell record of {} bytes", length);
+            continue;
+        }
+        std::vector<uint8_t> image(header.imageSize);
+        if (serde->ReadRecordData(image.data(), header.imageSize) != header.imageSize) {
+            logger::error("Truncated cell record ({}, {})", header.x, header.y);
+            continue;
+        }
+        // The worldspace comes from a plugin, its load order may have changed since the save
+        RE::FormID worldSpace = 0;
+        if (header.worldSpace && !serde->ResolveFormID(header.worldSpace, worldSpace)) {
+            continue;  // Plugin removed
+        }
+        saved.push_back({CellCoord{worldSpace, header.x, header.y}, std::move(image)});
+    }
+    const size_t read = saved.size();
+    const size_t loaded = WildfireMgr::GetSingleton()->LoadCellImages(std::move(saved));
+    if (loaded != read) {
+        logger::error("{} cell records don't decode, skipped", read - loaded);
+    }
+    logger::info("Loaded the fire state of {} cells", loaded);
+}
+
+void Serialization::RevertCallback(SKSE::SerializationInterface*) { WildfireMgr::GetSingleton()->ResetAllFireCells(); }
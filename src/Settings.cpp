@@ -67,9 +67,12 @@ void Settings::LoadSettings() {
     LoadAllPatterns("Data\\SKSE\\Plugins\\Wildfire\\FireSources", fireSources);
     LoadAllPatterns("Data\\SKSE\\Plugins\\Wildfire\\ColdSources", coldSources);
     LoadAllPatterns("Data\\SKSE\\Plugins\\Wildfire\\WaterSources", waterSources);
+    sourceMatcher.Compile(fireSources, coldSources, waterSources);
+    Utils::ClearSourceTypeCache();
 
     logger::info("Loaded {} grass configs", grassConfigs.size());
     logger::info("Loaded {} fire source patterns", fireSources.size());
     logger::info("Loaded {} cold source patterns", coldSources.size());
     logger::info("Loaded {} water source patterns", waterSources.size());
+    logger::info("Compiled source patterns into {} matcher states", sourceMatcher.GetStateCount());
 }
\ No newline at end of file
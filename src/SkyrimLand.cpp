@@ -0,0 +1,139 @@
+#include "SkyrimLand.h"
+#include "Settings.h"
+
+#include <cmath>
+#include <cstring>
+
+std::optional<CellCoord> SkyrimLand::GetCellAt(float worldX, float worldY) {
+    auto* tes = RE::TES::GetSingleton();
+    if (!tes || !tes->worldSpace) {
+        return std::nullopt;  // Interiors have no land
+    }
+    return CellCoord{tes->worldSpace->GetFormID(), static_cast<int>(std::floor(worldX / CellWorldSize)),
+                     static_cast<int>(std::floor(worldY / CellWorldSize))};
+}
+
+bool SkyrimLand::HasLand(const CellCoord& cell) { return GetLoadedData(cell) != nullptr; }
+
+VertexColors* SkyrimLand::GetVertexColors(const CellCoord& cell) {
+    auto* loadedData = GetLoadedData(cell);
+    if (!loadedData) {
+        return nullptr;
+    }
+    return reinterpret_cast<VertexColors*>(&loadedData->colors);
+}
+
+bool SkyrimLand::GetTextureLayers(const CellCoord& cell, LandTextureLayers& out) {
+    auto* loadedData = GetLoadedData(cell);
+    if (!loadedData) {
+        return false;
+    }
+    for (int q = 0; q < 4; ++q) {
+        out.defQuadTextures[q] = reinterpret_cast<TextureId>(loadedData->defQuadTextures[q]);
+        for (int texIdx = 0; texIdx < 6; ++texIdx) {
+            out.quadTextures[q][texIdx] = reinterpret_cast<TextureId>(loadedData->quadTextures[q][texIdx]);
+        }
+        for (int v = 0; v < 289; ++v) {
+            for (int texIdx = 0; texIdx < 6; ++texIdx) {
+                out.percents[q][v][texIdx] = (static_cast<float>(loadedData->percents[q][v][texIdx])) / 255.0f;
+            }
+        }
+    }
+    return true;
+}
+
+bool SkyrimLand::GetVertexHeights(const CellCoord& cell, VertexHeights& out) {
+    auto* loadedData = GetLoadedData(cell);
+    if (!loadedData) {
+        return false;
+    }
+    std::memcpy(out, loadedData->heights, sizeof(out));
+    return true;
+}
+
+float SkyrimLand::GetLandHeight(float worldX, float worldY) {
+    float height = 0.0f;
+    if (auto* tes = RE::TES::GetSingleton()) {
+        tes->GetLandHeight(RE::NiPoint3{worldX, worldY, 0.0f}, height);
+    }
+    return height;
+}
+
+void SkyrimLand::GetTextureGrassConfigs(TextureId texture, std::vector<GrassFireConfig>& out) {
+    auto* tex = reinterpret_cast<RE::TESLandTexture*>(texture);
+    if (!tex) {
+        return;
+    }
+    auto* set = Settings::GetSingleton();
+
+    // Check grass list
+    for (const auto& grass : tex->textureGrassList) {
+        if (grass) {
+            // We dont have a name or EditorID for grass objects so we need to use model path :(
+            auto model = grass->As<RE::TESModel>();
+            auto modelPath = model ? model->model : "";
+            std::string modelString = modelPath.c_str();
+            for (const auto& entry : set->grassConfigs) {
+                if (modelString.find(entry.name) != std::string::npos) {
+                    out.push_back(entry);
+                }
+            }
+        }
+    }
+}
+
+WindData SkyrimLand::GetCurrentWind() {
+    auto sky = RE::Sky::GetSingleton();
+    if (!sky || !sky->currentWeather) {
+        return {0, 0};
+    }
+    auto& data = sky->currentWeather->data;
+    uint8_t windSpeed = data.windSpeed;
+    uint8_t windDirection = data.windDirection;
+    return {windSpeed, windDirection};
+}
+
+bool SkyrimLand::IsCurrentWeatherRaining() {
+    auto sky = RE::Sky::GetSingleton();
+    if (!sky || !sky->currentWeather) {
+        return false;
+    }
+    const auto& weatherData = sky->currentWeather->data;
+    bool rain = weatherData.flags.any(RE::TESWeather::WeatherDataFlag::kRainy);
+    bool snow = weatherData.flags.any(RE::TESWeather::WeatherDataFlag::kSnow);
+
+    return rain || snow;
+}
+
+RE::TESObjectCELL* SkyrimLand::GetCell(const CellCoord& cell) {
+    auto* result = reinterpret_cast<RE::TESObjectCELL*>(cells.GetHandle(cell));
+    // Detaching is only noticed once per tick, don't hand out a cell that is already gone
+    if (!result || !result->IsAttached()) {
+        return nullptr;
+    }
+    return result;
+}
+
+std::optional<CellCoord> SkyrimLand::GetCellCoord(RE::TESObjectCELL* cell) {
+    if (!cell) {
+        return std::nullopt;
+    }
+    auto coords = cell->GetCoordinates();
+    if (!coords) {
+        return std::nullopt;  // Interior
+    }
+    auto* worldSpace = cell->GetRuntimeData().worldSpace;
+    return CellCoord{worldSpace ? worldSpace->GetFormID() : 0, coords->cellX, coords->cellY};
+}
+
+RE::TESObjectLAND::LoadedLandData* SkyrimLand::GetLoadedData(const CellCoord& cell) {
+    auto* tesCell = GetCell(cell);
+    if (!tesCell) {
+        return nullptr;
+    }
+    auto* cellLand = tesCell->GetRuntimeData().cellLand;
+    if (!cellLand) {
+        return nullptr;
+    }
+    return cellLand->loadedData;
+}
@@ -0,0 +1,90 @@
+#include "SourceMatcher.h"
+
+#include <queue>
+
+namespace {
+    constexpr uint8_t Lower(unsigned char c) { return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c; }
+}
+
+void SourceMatcher::Compile(const std::vector<std::string>& fire, const std::vector<std::string>& cold,
+                            const std::vector<std::string>& water) {
+    const std::pair<const std::vector<std::string>*, ProjectileType> lists[] = {
+        {&fire, ProjectileType::Fire}, {&cold, ProjectileType::Cold}, {&water, ProjectileType::Water}};
+
+    // Only bytes used by a pattern get their own column
+    std::fill(std::begin(charClass), std::end(charClass), uint16_t{0});
+    classCount = 1;
+    for (const auto& [patterns, type] : lists) {
+        for (const auto& pattern : *patterns) {
+            for (unsigned char c : pattern) {
+                auto& cls = charClass[Lower(c)];
+                if (!cls) cls = static_cast<uint16_t>(classCount++);
+            }
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        charClass[c] = charClass[c - 'A' + 'a'];
+    }
+
+    // Trie, -1 marks a missing edge until the failure links fill it
+    next.assign(classCount, -1);
+    output.assign(1, 0);
+    for (const auto& [patterns, type] : lists) {
+        for (const auto& pattern : *patterns) {
+            int32_t state = 0;
+            for (unsigned char c : pattern) {
+                size_t edge = static_cast<size_t>(state) * classCount + charClass[c];
+                if (next[edge] < 0) {
+                    next[edge] = static_cast<int32_t>(output.size());
+                    output.push_back(0);
+                    next.resize(next.size() + classCount, -1);
+                }
+                state = next[edge];
+            }
+            output[state] |= 1 << type;
+        }
+    }
+
+    // Breadth first over the trie: missing edges take the edge of the failure state, outputs collect along it
+    std::vector<int32_t> fail(output.size(), 0);
+    std::queue<int32_t> pending;
+    for (int cls = 0; cls < classCount; ++cls) {
+        auto& edge = next[cls];
+        if (edge < 0) {
+            edge = 0;
+        } else {
+            pending.push(edge);
+        }
+    }
+    while (!pending.empty()) {
+        int32_t state = pending.front();
+        pending.pop();
+        output[state] |= output[fail[state]];
+        for (int cls = 0; cls < classCount; ++cls) {
+            auto& edge = next[static_cast<size_t>(state) * classCount + cls];
+            int32_t fallback = next[static_cast<size_t>(fail[state]) * classCount + cls];
+            if (edge < 0) {
+                edge = fallback;
+            } else {
+                fail[edge] = fallback;
+                pending.push(edge);
+            }
+        }
+    }
+}
+
+ProjectileType SourceMatcher::Match(const char* text) const {
+    if (!text || output.empty()) {
+        return ProjectileType::Unknown;
+    }
+    uint8_t found = output[0];  // Empty patterns match everything
+    int32_t state = 0;
+    for (; *text && !(found & (1 << ProjectileType::Fire)); ++text) {
+        state = next[static_cast<size_t>(state) * classCount + charClass[static_cast<unsigned char>(*text)]];
+        found |= output[state];
+    }
+    for (auto type : {ProjectileType::Fire, ProjectileType::Cold, ProjectileType::Water}) {
+        if (found & (1 << type)) return type;
+    }
+    return ProjectileType::Unknown;
+}
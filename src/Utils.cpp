@@ -3,6 +3,8 @@
 #include "WildfireMgr.h"
 #include "Types.h"
 
+#include <shared_mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace Utils {
@@ -52,127 +54,38 @@ namespace Utils {
         return ret;
     }
 
-    RE::NiPoint3 GetWorldPosition(const FireVertex& vertex) {
-        if (!vertex.cell) return RE::NiPoint3{0.0f, 0.0f, 0.0f};
-
-        // Get cell grid coordinates
-        auto coords = vertex.cell->GetCoordinates();
-        int cellX = coords->cellX;
-        int cellY = coords->cellY;
-
-        // Cell world origin
-        float cellWorldX = cellX * 4096.0f;
-        float cellWorldY = cellY * 4096.0f;
-
-        // Quadrant (qx, qy)
-        int qx = vertex.quadrant % 2;
-        int qy = vertex.quadrant / 2;
-
-        // Quadrant world offset
-        float quadWorldX = cellWorldX + qx * 2048.0f;
-        float quadWorldY = cellWorldY + qy * 2048.0f;
-
-        // Vertex (vx, vy) in quadrant
-        int vx = vertex.vertex % 17;
-        int vy = vertex.vertex / 17;
-
-        // Vertex world offset
-        float vertWorldX = quadWorldX + vx * 128.0f;
-        float vertWorldY = quadWorldY + vy * 128.0f;
-
-        float vertWorldZ = 0.0f;
-        RE::TES::GetSingleton()->GetLandHeight(RE::NiPoint3{vertWorldX, vertWorldY, 0.0f}, vertWorldZ);
-
-        return RE::NiPoint3{vertWorldX, vertWorldY, vertWorldZ};
-    }
-
-    std::tuple<bool, uint8_t, uint8_t> GetGrassData(RE::TESObjectLAND::LoadedLandData* loadedData, int q, int v) {
-        auto set = Settings::GetSingleton();
-        bool canBurn = false;
-        uint8_t fuel = set->DefaultInitialFuelAmount;
-        uint8_t minBurnHeat = set->DefaultMinHeatToBurn;
-        bool defaultConfig = true;
-
-        float defaultTexturePercent = 1.0f;
-
-        for (int texIdx = 0; texIdx < 6; ++texIdx) {
-            // Check percent coverage
-            float percent = (static_cast<float>(loadedData->percents[q][v][texIdx])) / 255.0f;
-            defaultTexturePercent -= percent;
-            if (percent > 0.0f) {
-                RE::TESLandTexture* tex = loadedData->quadTextures[q][texIdx];
-                if (!tex) continue;
-
-                // Check grass list
-                for (const auto& grass : tex->textureGrassList) {
-                    if (grass) {
-                        // We dont have a name or EditorID for grass objects so we need to use model path :(
-                        auto model = grass->As<RE::TESModel>();
-                        auto modelPath = model ? model->model : "";
-                        std::string modelString = modelPath.c_str();
-                        for (const auto& entry : set->grassConfigs) {
-                            if (modelString.find(entry.name) != std::string::npos) {
-                                if (defaultConfig) {
-                                    canBurn = entry.canBurn;
-                                    fuel = entry.fuel;
-                                    minBurnHeat = entry.minBurnHeat;
-                                    defaultConfig = false;
-                                } else {
-                                    canBurn = canBurn || entry.canBurn;
-                                    fuel = (fuel + entry.fuel) / 2;
-                                    minBurnHeat = (minBurnHeat + entry.minBurnHeat) / 2;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        if (defaultTexturePercent > 0.0f) {
-            RE::TESLandTexture* tex = loadedData->defQuadTextures[q];
-            if (!tex) return {canBurn, fuel, minBurnHeat};
-
-            // Check grass list
-            for (const auto& grass : tex->textureGrassList) {
-                if (grass) {
-                    // We dont have a name or EditorID for grass objects so we need to use model path :(
-                    auto model = grass->As<RE::TESModel>();
-                    auto modelPath = model ? model->model : "";
-                    std::string modelString = modelPath.c_str();
-                    for (const auto& entry : set->grassConfigs) {
-                        if (modelString.find(entry.name) != std::string::npos) {
-                            if (defaultConfig) {
-                                canBurn = entry.canBurn;
-                                fuel = entry.fuel;
-                                minBurnHeat = entry.minBurnHeat;
-                                defaultConfig = false;
-                            } else {
-                                canBurn = canBurn || entry.canBurn;
-                                fuel = (fuel + entry.fuel) / 2;
-                                minBurnHeat = (minBurnHeat + entry.minBurnHeat) / 2;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-
-        return {canBurn, fuel, minBurnHeat};
-    }
-
     std::string ToLower(std::string s) {
         std::transform(s.begin(), s.end(), s.begin(),
                        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
         return s;
     }
     
-    static bool MatchesAnyPattern(const std::string& lower, const std::vector<std::string>& patterns) {
-        for (const auto& pat : patterns) {
-            if (lower.find(pat) != std::string::npos) {
-                return true;
-            }
-        }
-        return false;
+    // Type of every source form classified so far, Unknown included so unrelated forms are only matched once.
+    // Keyed by FormID, dynamic forms (0xFF index) are not cached since their IDs are reused once they are deleted.
+    static std::shared_mutex formTypesMutex;
+    static std::unordered_map<RE::FormID, ProjectileType> formTypes;
+
+    template <class Func>
+    static ProjectileType GetCachedType(const RE::TESForm* form, Func&& classify) {
+        const RE::FormID formID = form->GetFormID();
+        if ((formID >> 24) == 0xFF) {
+            return classify();
+        }
+        {
+            std::shared_lock lock(formTypesMutex);
+            if (auto it = formTypes.find(formID); it != formTypes.end()) {
+                return it->second;
+            }
+        }
+        auto type = classify();
+        std::unique_lock lock(formTypesMutex);
+        formTypes.try_emplace(formID, type);
+        return type;
+    }
+
+    void ClearSourceTypeCache() {
+        std::unique_lock lock(formTypesMutex);
+        formTypes.clear();
     }
 
     ProjectileType GetProjectileType(RE::Projectile* proj) {
@@ -180,135 +93,53 @@ namespace Utils {
             return ProjectileType::Unknown;
         }
 
-        auto set = Settings::GetSingleton();
+        const auto& matcher = Settings::GetSingleton()->sourceMatcher;
+        // Editor ID first, then the display name
+        auto matchForm = [&matcher](auto* form) {
+            auto type = matcher.Match(form->GetFormEditorID());
+            return type != ProjectileType::Unknown ? type : matcher.Match(form->GetFullName());
+        };
 
         // 1. Source spell/magic item
         if (auto spellSource = proj->GetProjectileRuntimeData().spell) {
-            if (auto editorID = spellSource->GetFormEditorID()) {
-                std::string lowerID = ToLower(editorID);
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
-                }
-            }
-            if (auto fulName = spellSource->GetFullName()) {
-                std::string lowerID = ToLower(fulName);
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
-                }
-            }
-
-            // Check base effects of the spell
-            for (auto MagEf : spellSource->effects) {
-                if (MagEf && MagEf->baseEffect) {
-                    if (auto editorID = MagEf->baseEffect->GetFormEditorID()) {
-                        std::string lowerID = ToLower(editorID);
-                        if (MatchesAnyPattern(lowerID, set->fireSources)) {
-
-                            return ProjectileType::Fire;
-                        }
-                        if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                            return ProjectileType::Cold;
-                        }
-                        if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                            return ProjectileType::Water;
-                        }
-                    }
-                    if (auto fullName = MagEf->baseEffect->GetFullName()) {
-                        std::string lowerID = ToLower(fullName);
-                        if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                            return ProjectileType::Fire;
-                        }
-                        if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                            return ProjectileType::Cold;
-                        }
-                        if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                            return ProjectileType::Water;
+            auto type = GetCachedType(spellSource, [&]() {
+                if (auto spellType = matchForm(spellSource); spellType != ProjectileType::Unknown) {
+                    return spellType;
+                }
+                // Check base effects of the spell
+                for (auto MagEf : spellSource->effects) {
+                    if (MagEf && MagEf->baseEffect) {
+                        if (auto effectType = matchForm(MagEf->baseEffect); effectType != ProjectileType::Unknown) {
+                            return effectType;
                         }
                     }
                 }
+                return ProjectileType::Unknown;
+            });
+            if (type != ProjectileType::Unknown) {
+                return type;
             }
         }
 
         // 2. Ammo source
         if (auto ammoSource = proj->GetProjectileRuntimeData().ammoSource) {
-            if (auto editorID = ammoSource->GetFormEditorID()) {
-                std::string lowerID = ToLower(editorID);
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
-                }
-            }
-            if (auto fullName = ammoSource->GetFullName()) {
-                std::string lowerID = ToLower(fullName);
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
-                }
+            auto type = GetCachedType(ammoSource, [&]() { return matchForm(ammoSource); });
+            if (type != ProjectileType::Unknown) {
+                return type;
             }
         }
 
         // 3. Weapon source
         if (auto weapSource = proj->GetProjectileRuntimeData().weaponSource) {
-            if (auto editorID = weapSource->GetFormEditorID()) {
-                std::string lowerID = ToLower(editorID);
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
-                }
-            }
-            if (auto fullName = weapSource->GetFullName()) {
-                std::string lowerID = ToLower(fullName);
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
-                }
+            auto type = GetCachedType(weapSource, [&]() { return matchForm(weapSource); });
+            if (type != ProjectileType::Unknown) {
+                return type;
             }
         }
 
-        // 4. Projectile's own ID/name
-        if (auto editorID = proj->GetFormEditorID()) {
-            std::string lowerID = ToLower(editorID);
-            if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                return ProjectileType::Fire;
-            }
-            if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                return ProjectileType::Cold;
-            }
-            if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                return ProjectileType::Water;
-            }
+        // 4. Projectile's own ID, taken from its base form so it can be cached
+        if (auto base = proj->GetBaseObject()) {
+            return GetCachedType(base, [&]() { return matcher.Match(base->GetFormEditorID()); });
         }
         return ProjectileType::Unknown;
     }
@@ -318,22 +149,17 @@ namespace Utils {
             return ProjectileType::Unknown;
         }
 
-        auto set = Settings::GetSingleton();
-
         if (auto base = exp->GetBaseObject()) {
-            if (auto model = base->As<RE::TESModel>()) {
-                std::string lowerID = ToLower(model->model.c_str());
-                if (MatchesAnyPattern(lowerID, set->fireSources)) {
-                    return ProjectileType::Fire;
-                }
-                if (MatchesAnyPattern(lowerID, set->coldSources)) {
-                    return ProjectileType::Cold;
-                }
-                if (MatchesAnyPattern(lowerID, set->waterSources)) {
-                    return ProjectileType::Water;
+            return GetCachedType(base, [base]() {
+                if (auto model = base->As<RE::TESModel>()) {
+                    auto type = Settings::GetSingleton()->sourceMatcher.Match(model->model.c_str());
+                    if (type == ProjectileType::Unknown) {
+                        logger::debug("Explosion model {}", model->model.c_str());
+                    }
+                    return type;
                 }
-                logger::debug("Explosion model {}", model->model.c_str());
-            }
+                return ProjectileType::Unknown;
+            });
         }
         return ProjectileType::Unknown;
     }
@@ -2,6 +2,7 @@
 #include "Events.h"
 #include "Hooks.h"
 #include "MCP.h"
+#include "Serialization.h"
 #include "Utils.h"
 #include "Settings.h"
 #include "HazardMgr.h"
@@ -10,6 +11,7 @@
 void OnMessage(SKSE::MessagingInterface::Message* message) {
     if (message->type == SKSE::MessagingInterface::kDataLoaded) {
         Hooks::InstallHooks();
+        Events::CellLoadHandler::Register();
         HazardMgr::GetSingleton()->InitializeHazards();
         Settings::GetSingleton()->LoadSettings();
         MCP::Register();
@@ -17,6 +19,7 @@ void OnMessage(SKSE::MessagingInterface::Message* message) {
     }
     if (message->type == SKSE::MessagingInterface::kPreLoadGame) {
         WildfireMgr::GetSingleton()->ResetAllFireCells();
+        Utils::ClearSourceTypeCache();
     }
 }
 
@@ -25,6 +28,7 @@ SKSEPluginLoad(const SKSE::LoadInterface *skse) {
     SetupLog();
     logger::info("Plugin loaded");
     SKSE::Init(skse);
+    Serialization::Install();
     SKSE::GetMessagingInterface()->RegisterListener(OnMessage);
     return true;
 }